@@ -10,6 +10,7 @@
 #include "driver/gpio.h"
 #include "esp_system.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "ds18b20.h"
 #include "owb.h"
@@ -19,6 +20,11 @@ static const char * TAG = "ds18b20";
 // Tempo máximo de conversão a 12 bits (em ms)
 static const int T_CONV_MS = 750;
 
+// COPY SCRATCHPAD: até 10 ms gravando a EEPROM
+#define T_COPY_MS 10
+// RECALL E²: o sensor responde 0 nos read slots até terminar
+#define RECALL_MAX_POLLS 16
+
 // Comandos do DS18B20
 #define DS18B20_FUNCTION_TEMP_CONVERT       0x44
 #define DS18B20_FUNCTION_SCRATCHPAD_WRITE   0x4E
@@ -47,7 +53,10 @@ static void _init(DS18B20_Info * ds, const OneWireBus * bus)
         memset(&ds->rom_code, 0, sizeof(ds->rom_code));
         ds->use_crc = false;
         ds->resolution = DS18B20_RESOLUTION_INVALID;
+        memset(&ds->config, 0, sizeof(ds->config));
         ds->solo = false;
+        ds->overdrive = false;
+        ds->overdrive_fallbacks = 0;
         ds->init = true;
     }
     else
@@ -99,6 +108,91 @@ static bool _address_device(const DS18B20_Info * ds)
     return present;
 }
 
+// Desliga o overdrive deste sensor: daqui em diante só velocidade padrão
+static void _overdrive_fallback(DS18B20_Info * ds, const char * reason)
+{
+    ds->overdrive = false;
+    ds->overdrive_fallbacks++;
+    ESP_LOGW(TAG, "overdrive desligado (%s), usando velocidade padrão", reason);
+}
+
+// ⚡ Overdrive Match ROM + comando + dados; o barramento volta à velocidade
+// padrão no fim (o sensor volta no próximo reset padrão)
+static bool _transaction_overdrive(const DS18B20_Info * ds, const uint8_t * tx, size_t tx_len,
+                                   uint8_t * rx, size_t rx_len)
+{
+    bool present = false;
+    owb_status status = owb_overdrive_match(ds->bus, ds->rom_code, &present);
+    if (status == OWB_STATUS_OK && present)
+    {
+        status = owb_write_bytes(ds->bus, tx, tx_len);
+    }
+    if (status == OWB_STATUS_OK && present && rx_len)
+    {
+        status = owb_read_bytes(ds->bus, rx, rx_len);
+    }
+    owb_set_overdrive(ds->bus, false);
+    return status == OWB_STATUS_OK && present;
+}
+
+// Reset + endereçamento + comando + dados de uma vez (owb_transaction): com
+// o driver RMT é uma única transação de hardware
+#define TRANSACTION_MAX_DATA 3
+static DS18B20_ERROR _transaction(DS18B20_Info * ds, uint8_t function, const uint8_t * tx, size_t tx_len,
+                                  uint8_t * rx, size_t rx_len)
+{
+    uint8_t buffer[1 + sizeof(OneWireBus_ROMCode) + 1 + TRANSACTION_MAX_DATA];
+    size_t n = 0;
+
+    if (!_is_init(ds) || tx_len > TRANSACTION_MAX_DATA)
+    {
+        return DS18B20_ERROR_UNKNOWN;
+    }
+    if (ds->overdrive)
+    {
+        buffer[0] = function;
+        if (tx_len)
+        {
+            memcpy(&buffer[1], tx, tx_len);
+        }
+        if (_transaction_overdrive(ds, buffer, 1 + tx_len, rx, rx_len))
+        {
+            return DS18B20_OK;
+        }
+        // Sem resposta em overdrive: repete em velocidade padrão
+        _overdrive_fallback(ds, "sem resposta");
+    }
+    if (ds->solo)
+    {
+        buffer[n++] = OWB_ROM_SKIP;
+    }
+    else
+    {
+        buffer[n++] = OWB_ROM_MATCH;
+        memcpy(&buffer[n], ds->rom_code.bytes, sizeof(ds->rom_code.bytes));
+        n += sizeof(ds->rom_code.bytes);
+    }
+    buffer[n++] = function;
+    if (tx_len)
+    {
+        memcpy(&buffer[n], tx, tx_len);
+        n += tx_len;
+    }
+
+    bool present = false;
+    if (owb_transaction(ds->bus, buffer, n, rx, rx_len, &present) != OWB_STATUS_OK)
+    {
+        ESP_LOGE(TAG, "falha na transação 0x%02X", function);
+        return DS18B20_ERROR_OWB;
+    }
+    if (!present)
+    {
+        ESP_LOGE(TAG, "Nenhum dispositivo responde no barramento (_transaction)");
+        return DS18B20_ERROR_DEVICE;
+    }
+    return DS18B20_OK;
+}
+
 
 static bool _check_resolution(DS18B20_RESOLUTION r)
 {
@@ -127,74 +221,108 @@ static float _decode_temp(uint8_t lsb, uint8_t msb, DS18B20_RESOLUTION resolutio
 }
 
 
-static DS18B20_ERROR _read_scratchpad(const DS18B20_Info * ds, Scratchpad * sp)
+static DS18B20_ERROR _read_scratchpad(DS18B20_Info * ds, Scratchpad * sp, bool check_crc)
 {
     if (!sp)
     {
         return DS18B20_ERROR_NULL;
     }
 
-    DS18B20_ERROR err = DS18B20_ERROR_UNKNOWN;
-
-    if (_address_device(ds))
+    // Comando "Read Scratchpad"
+    DS18B20_ERROR err = _transaction(ds, DS18B20_FUNCTION_SCRATCHPAD_READ, NULL, 0, (uint8_t *)sp, sizeof(*sp));
+    if (err == DS18B20_OK)
     {
-        // Comando "Read Scratchpad"
-        if (owb_write_byte(ds->bus, DS18B20_FUNCTION_SCRATCHPAD_READ) == OWB_STATUS_OK)
+        if (check_crc)
         {
-           
-            if (owb_read_bytes(ds->bus, (uint8_t *)sp, sizeof(*sp)) == OWB_STATUS_OK)
+            if (owb_crc8_bytes(0, (uint8_t *)sp, sizeof(*sp)) != 0 && ds->overdrive)
             {
-                err = DS18B20_OK;
-                if (ds->use_crc)
-                {
-                   
-                    if (owb_crc8_bytes(0, (uint8_t *)sp, sizeof(*sp)) != 0)
-                    {
-                        ESP_LOGE(TAG, "Scratchpad com CRC inválido");
-                        err = DS18B20_ERROR_CRC;
-                    }
-                }
-                else
-                {
-                   
-                    bool dummy_present;
-                    owb_reset(ds->bus, &dummy_present);
-                }
+                // Bits errados em overdrive: margem de tempo insuficiente no barramento.
+                // Repete uma vez em velocidade padrão antes de dar o CRC como erro.
+                _overdrive_fallback(ds, "CRC");
+                err = _transaction(ds, DS18B20_FUNCTION_SCRATCHPAD_READ, NULL, 0, (uint8_t *)sp, sizeof(*sp));
             }
-            else
+            if (err == DS18B20_OK && owb_crc8_bytes(0, (uint8_t *)sp, sizeof(*sp)) != 0)
             {
-                ESP_LOGE(TAG, "falha owb_read_bytes");
-                err = DS18B20_ERROR_OWB;
+                ESP_LOGE(TAG, "Scratchpad com CRC inválido");
+                err = DS18B20_ERROR_CRC;
             }
         }
         else
         {
-            ESP_LOGE(TAG, "falha owb_write_byte(SCRATCHPAD_READ)");
-            err = DS18B20_ERROR_OWB;
+            bool dummy_present;
+            owb_reset(ds->bus, &dummy_present);
         }
     }
-    else
+
+    return err;
+}
+
+static bool _write_scratchpad(DS18B20_Info * ds, const Scratchpad * sp)
+{
+    return _transaction(ds, DS18B20_FUNCTION_SCRATCHPAD_WRITE, &sp->trigger_high, 3, NULL, 0) == DS18B20_OK;
+}
+
+static DS18B20_RESOLUTION _resolution_from_config(uint8_t configuration)
+{
+    return ((configuration >> 5) & 0x03) + DS18B20_RESOLUTION_9_BIT;  // R1..R0
+}
+
+static uint8_t _config_from_resolution(DS18B20_RESOLUTION r)
+{
+    return (((r - 1) & 0x03) << 5) | 0x1F;
+}
+
+// Atualiza o espelho com o que veio do sensor (mudanças locais pendentes têm prioridade)
+static void _shadow_load(DS18B20_Info * ds, const Scratchpad * sp)
+{
+    if (!ds->config.dirty)
     {
-        err = DS18B20_ERROR_DEVICE;
+        ds->config.trigger_high = sp->trigger_high;
+        ds->config.trigger_low = sp->trigger_low;
+        ds->config.configuration = sp->configuration;
+        ds->config.valid = true;
     }
+}
 
-    return err;
+// Garante um espelho válido; só vai ao barramento na primeira vez
+static bool _shadow_ensure(DS18B20_Info * ds)
+{
+    if (ds->config.valid)
+    {
+        return true;
+    }
+    Scratchpad sp = {0};
+    if (_read_scratchpad(ds, &sp, true) != DS18B20_OK)
+    {
+        return false;
+    }
+    _shadow_load(ds, &sp);
+    return true;
 }
 
-static bool _write_scratchpad(const DS18B20_Info * ds, const Scratchpad * sp)
+// Sensor voltou de um reset (leu 85.0 de power-on): ele já recarregou a
+// EEPROM sozinho. Se o espelho bate com a EEPROM, o scratchpad já está certo
+// e nada vai ao barramento; senão a configuração que estava só no
+// scratchpad precisa ser reescrita.
+static void _restore_config(DS18B20_Info * ds)
 {
-    bool ok = false;
-    if (_is_init(ds))
+    ds->power_on_restores++;
+    if (!ds->config.valid)
     {
-        if (_address_device(ds))
-        {
-            
-            owb_write_byte(ds->bus, DS18B20_FUNCTION_SCRATCHPAD_WRITE);
-            owb_write_bytes(ds->bus, (uint8_t *)&sp->trigger_high, 3);
-            ok = true;
-        }
+        return;
+    }
+    if (ds->config.eeprom_synced)
+    {
+        ds->config.dirty = false;
+        ds->resolution = _resolution_from_config(ds->config.configuration);
+        ESP_LOGW(TAG, "Sensor reiniciou; configuração já veio da EEPROM");
+    }
+    else
+    {
+        ds->config.dirty = true;
+        ds18b20_config_write(ds);
+        ESP_LOGW(TAG, "Sensor reiniciou; configuração reescrita no scratchpad");
     }
-    return ok;
 }
 
 // ======================================================
@@ -230,6 +358,14 @@ void ds18b20_init(DS18B20_Info * ds, const OneWireBus * bus, OneWireBus_ROMCode
     {
         _init(ds, bus);
         ds->rom_code = rom_code;  // salva qual dispositivo
+        if (bus && bus->use_overdrive)
+        {
+            // Só usa overdrive se o sensor responder a um reset em overdrive
+            bool supported = false;
+            owb_overdrive_probe(bus, rom_code, &supported);
+            ds->overdrive = supported;
+            ESP_LOGI(TAG, "overdrive %s", supported ? "suportado" : "não suportado, velocidade padrão");
+        }
         ds->resolution = ds18b20_read_resolution(ds);
     }
     else
@@ -273,52 +409,143 @@ bool ds18b20_set_resolution(DS18B20_Info * ds, DS18B20_RESOLUTION r)
         return false;
     }
 
-    // Lê scratchpad completo
-    Scratchpad sp = {0};
-    DS18B20_ERROR err = _read_scratchpad(ds, &sp);
-    if (err == DS18B20_OK || err == DS18B20_ERROR_CRC)
+    // TH/TL vêm do espelho: sem ler o scratchpad antes de cada escrita
+    ds18b20_config_set_resolution(ds, r);
+    if (!ds18b20_config_write(ds))
     {
-        
-        uint8_t conf_value = (((r - 1) & 0x03) << 5) | 0x1F;
-        sp.configuration = conf_value;
+        ESP_LOGE(TAG, "Falha ao escrever config no scratchpad");
+        return false;
+    }
+    return true;
+}
 
-    
-        if (_write_scratchpad(ds, &sp))
+DS18B20_RESOLUTION ds18b20_read_resolution(DS18B20_Info * ds)
+{
+    DS18B20_RESOLUTION r = DS18B20_RESOLUTION_INVALID;
+    if (_is_init(ds) && _shadow_ensure(ds))
+    {
+        DS18B20_RESOLUTION tmp = _resolution_from_config(ds->config.configuration);
+        if (_check_resolution(tmp))
         {
-            ds->resolution = r;
-            return true;
+            r = tmp;
         }
         else
         {
-            ESP_LOGE(TAG, "Falha ao escrever config no scratchpad");
-            return false;
+            ESP_LOGE(TAG, "Config indica resolução inválida: 0x%02X", ds->config.configuration);
         }
     }
-    return false;
+    return r;
 }
 
-DS18B20_RESOLUTION ds18b20_read_resolution(DS18B20_Info * ds)
+void ds18b20_config_set_resolution(DS18B20_Info * ds, DS18B20_RESOLUTION r)
 {
-    DS18B20_RESOLUTION r = DS18B20_RESOLUTION_INVALID;
-    if (_is_init(ds))
+    if (!_is_init(ds) || !_check_resolution(r) || !_shadow_ensure(ds))
+    {
+        return;
+    }
+    uint8_t conf_value = _config_from_resolution(r);
+    if (ds->config.configuration != conf_value)
+    {
+        ds->config.configuration = conf_value;
+        ds->config.dirty = true;
+    }
+}
+
+void ds18b20_config_set_alarms(DS18B20_Info * ds, int8_t high_c, int8_t low_c)
+{
+    if (!_is_init(ds) || !_shadow_ensure(ds))
+    {
+        return;
+    }
+    if (ds->config.trigger_high != (uint8_t)high_c || ds->config.trigger_low != (uint8_t)low_c)
+    {
+        ds->config.trigger_high = (uint8_t)high_c;
+        ds->config.trigger_low = (uint8_t)low_c;
+        ds->config.dirty = true;
+    }
+}
+
+bool ds18b20_config_write(DS18B20_Info * ds)
+{
+    if (!_is_init(ds) || !ds->config.valid)
+    {
+        return false;
+    }
+    if (!ds->config.dirty)
+    {
+        return true;  // Nada mudou: nenhum tráfego
+    }
+
+    Scratchpad sp = {
+        .trigger_high = ds->config.trigger_high,
+        .trigger_low = ds->config.trigger_low,
+        .configuration = ds->config.configuration,
+    };
+    if (!_write_scratchpad(ds, &sp))
     {
-        Scratchpad sp = {0};
-        DS18B20_ERROR err = _read_scratchpad(ds, &sp);
-        if (err == DS18B20_OK || err == DS18B20_ERROR_CRC)
+        return false;
+    }
+    ds->config.dirty = false;
+    ds->config.eeprom_synced = false;
+    ds->resolution = _resolution_from_config(ds->config.configuration);
+    return true;
+}
+
+bool ds18b20_config_save(DS18B20_Info * ds)
+{
+    if (!ds18b20_config_write(ds))
+    {
+        return false;
+    }
+    if (ds->config.eeprom_synced)
+    {
+        return true;  // EEPROM já tem isso: poupa um ciclo de gravação
+    }
+    if (!_address_device(ds))
+    {
+        return false;
+    }
+
+    owb_write_byte(ds->bus, DS18B20_FUNCTION_SCRATCHPAD_COPY);
+    owb_set_strong_pullup(ds->bus, true);   // Parasita: a gravação consome do barramento
+    vTaskDelay(pdMS_TO_TICKS(T_COPY_MS) + 1);
+    owb_set_strong_pullup(ds->bus, false);
+
+    ds->config.eeprom_synced = true;
+    return true;
+}
+
+bool ds18b20_config_recall(DS18B20_Info * ds)
+{
+    if (!_is_init(ds) || !_address_device(ds))
+    {
+        return false;
+    }
+
+    owb_write_byte(ds->bus, DS18B20_FUNCTION_EEPROM_RECALL);
+    for (int i = 0; i < RECALL_MAX_POLLS; i++)
+    {
+        uint8_t bit = 0;
+        if (owb_read_bit(ds->bus, &bit) == OWB_STATUS_OK && bit)
         {
-            uint8_t bits = (sp.configuration >> 5) & 0x03;  // R1..R0
-            DS18B20_RESOLUTION tmp = bits + DS18B20_RESOLUTION_9_BIT;
-            if (_check_resolution(tmp))
-            {
-                r = tmp;
-            }
-            else
-            {
-                ESP_LOGE(TAG, "Config indica resolução inválida: 0x%02X", sp.configuration);
-            }
+            break;
         }
     }
-    return r;
+
+    // Espelho = EEPROM só se já sabíamos o que ela tinha
+    if (ds->config.eeprom_synced)
+    {
+        ds->config.dirty = false;
+        ds->resolution = _resolution_from_config(ds->config.configuration);
+    }
+    else
+    {
+        ds->config.valid = false;
+        ds->config.dirty = false;
+        ds->resolution = ds18b20_read_resolution(ds);
+        ds->config.eeprom_synced = ds->config.valid;
+    }
+    return true;
 }
 
 OneWireBus_ROMCode ds18b20_read_rom(DS18B20_Info * ds)
@@ -395,7 +622,29 @@ float ds18b20_wait_for_conversion(const DS18B20_Info * ds)
 }
 
 
-DS18B20_ERROR ds18b20_read_temp(const DS18B20_Info * ds, float * out_value)
+static bool _is_power_on_value(const Scratchpad * sp)
+{
+    return sp->reserved[1] == 0x0c && sp->temperature[1] == 0x05 && sp->temperature[0] == 0x50;
+}
+
+// Decodifica o scratchpad completo, recusando o valor de power-on (85.0)
+static DS18B20_ERROR _temp_from_scratchpad(const DS18B20_Info * ds, const Scratchpad * sp, float * out_value)
+{
+    if (_is_power_on_value(sp))
+    {
+        ESP_LOGE(TAG, "Leu valor de power-on (85.0), possivel DS18B20 não configurado");
+        return DS18B20_ERROR_DEVICE;
+    }
+
+    float temp = _decode_temp(sp->temperature[0], sp->temperature[1], ds->resolution);
+    if (out_value)
+    {
+        *out_value = temp;
+    }
+    return DS18B20_OK;
+}
+
+DS18B20_ERROR ds18b20_read_temp(DS18B20_Info * ds, float * out_value)
 {
     if (!_is_init(ds))
     {
@@ -404,29 +653,152 @@ DS18B20_ERROR ds18b20_read_temp(const DS18B20_Info * ds, float * out_value)
 
     // Lê scratchpad completo
     Scratchpad sp = {0};
-    DS18B20_ERROR err = _read_scratchpad(ds, &sp);
+    DS18B20_ERROR err = _read_scratchpad(ds, &sp, ds->use_crc);
     if (err == DS18B20_OK || err == DS18B20_ERROR_CRC)
     {
-       
-        if (sp.reserved[1] == 0x0c && sp.temperature[1] == 0x05 && sp.temperature[0] == 0x50)
+        err = _temp_from_scratchpad(ds, &sp, out_value);
+    }
+    return err;
+}
+
+void ds18b20_use_fast_read(DS18B20_Info * ds, uint8_t full_every, float max_rate_c_per_s)
+{
+    if (_is_init(ds))
+    {
+        ds->fast_full_every = full_every;
+        ds->fast_max_rate = max_rate_c_per_s;
+        ds->fast_since_full = 0;
+        ds->last_valid = false;  // A primeira leitura é sempre completa
+    }
+}
+
+// Só os 2 primeiros bytes do scratchpad; o reset encerra a transação
+// antes dos outros 7 (o sensor aceita a interrupção a qualquer momento)
+static DS18B20_ERROR _read_temperature_bytes(DS18B20_Info * ds, uint8_t temperature[2])
+{
+    DS18B20_ERROR err = _transaction(ds, DS18B20_FUNCTION_SCRATCHPAD_READ, NULL, 0, temperature, 2);
+    if (err != DS18B20_OK)
+    {
+        return err;
+    }
+    bool dummy_present;
+    owb_reset(ds->bus, &dummy_present);
+    return DS18B20_OK;
+}
+
+// Leitura completa com CRC obrigatório (também serve de referência para a rápida)
+static DS18B20_ERROR _read_temp_full(DS18B20_Info * ds, float * value)
+{
+    Scratchpad sp = {0};
+    DS18B20_ERROR err = _read_scratchpad(ds, &sp, true);
+    if (err == DS18B20_OK)
+    {
+        if (_is_power_on_value(&sp))
         {
-            ESP_LOGE(TAG, "Leu valor de power-on (85.0), possivel DS18B20 não configurado");
-            err = DS18B20_ERROR_DEVICE;
+            _restore_config(ds);
         }
         else
         {
-            float temp = _decode_temp(sp.temperature[0], sp.temperature[1], ds->resolution);
-            if (out_value)
-            {
-                *out_value = temp;
-            }
-            err = DS18B20_OK;
+            _shadow_load(ds, &sp);
         }
+        err = _temp_from_scratchpad(ds, &sp, value);
     }
+    ds->full_reads++;
     return err;
 }
 
-DS18B20_ERROR ds18b20_convert_and_read_temp(const DS18B20_Info * ds, float * out_value)
+DS18B20_ERROR ds18b20_read_temp_full(DS18B20_Info * ds, float * out_value)
+{
+    if (!_is_init(ds))
+    {
+        return DS18B20_ERROR_UNKNOWN;
+    }
+
+    float temp = 0.0f;
+    DS18B20_ERROR err = _read_temp_full(ds, &temp);
+    if (err != DS18B20_OK)
+    {
+        ds->last_valid = false;
+        return err;
+    }
+
+    // Nova referência para as leituras rápidas seguintes
+    ds->fast_since_full = 0;
+    ds->last_temp = temp;
+    ds->last_temp_us = esp_timer_get_time();
+    ds->last_valid = true;
+    if (out_value)
+    {
+        *out_value = temp;
+    }
+    return DS18B20_OK;
+}
+
+DS18B20_ERROR ds18b20_read_temp_fast(DS18B20_Info * ds, float * out_value)
+{
+    if (!_is_init(ds))
+    {
+        return DS18B20_ERROR_UNKNOWN;
+    }
+    if (ds->fast_full_every == 0)
+    {
+        return ds18b20_read_temp(ds, out_value);
+    }
+
+    int64_t now = esp_timer_get_time();
+    float temp = 0.0f;
+    bool need_full = !ds->last_valid || ds->fast_since_full >= ds->fast_full_every;
+
+    if (!need_full)
+    {
+        uint8_t t[2];
+        DS18B20_ERROR err = _read_temperature_bytes(ds, t);
+        if (err != DS18B20_OK)
+        {
+            return err;
+        }
+        ds->fast_reads++;
+
+        // Sem CRC: 0xFFFF é barramento solto e 85.0 pode ser um reset do
+        // sensor; ambos só valem depois de uma leitura completa
+        uint16_t raw = (t[1] << 8) | t[0];
+        temp = _decode_temp(t[0], t[1], ds->resolution);
+
+        // Plausibilidade: a taxa máxima no intervalo + 1 passo de 9 bits
+        float allowed = ds->fast_max_rate * (float)(now - ds->last_temp_us) / 1e6f + 0.5f;
+        if (raw == 0xFFFF || raw == 0x0550 || fabsf(temp - ds->last_temp) > allowed)
+        {
+            ds->implausible++;
+            need_full = true;
+        }
+        else
+        {
+            ds->fast_since_full++;
+        }
+    }
+
+    if (need_full)
+    {
+        DS18B20_ERROR err = _read_temp_full(ds, &temp);
+        if (err != DS18B20_OK)
+        {
+            ds->last_valid = false;
+            return err;
+        }
+        ds->fast_since_full = 0;
+    }
+
+    ds->last_temp = temp;
+    ds->last_temp_us = now;
+    ds->last_valid = true;
+    if (out_value)
+    {
+        *out_value = temp;
+    }
+    return DS18B20_OK;
+}
+
+DS18B20_ERROR ds18b20_convert_and_read_temp(DS18B20_Info * ds, float * out_value)
 {
     if (!_is_init(ds))
     {
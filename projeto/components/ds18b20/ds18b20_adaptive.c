@@ -0,0 +1,84 @@
+#include <string.h>
+#include <math.h>
+
+#include "ds18b20_adaptive.h"
+#include "ds18b20_sched.h"
+
+#define PERIOD_STEP_MS 50
+#define READ_MARGIN_MS 5     // Leituras dos scratchpads depois da conversão
+// A taxa é medida em janelas de pelo menos 2 s: a 10 Hz e 9 bits, a
+// diferença entre amostras vizinhas é quase só quantização (0,5 °C)
+#define RATE_WINDOW_US 2000000
+
+
+void ds18b20_adaptive_init(ds18b20_adaptive_t * ctrl, const ds18b20_adaptive_config_t * config)
+{
+    memset(ctrl, 0, sizeof(*ctrl));
+    ctrl->config = *config;
+    ctrl->resolution = DS18B20_RESOLUTION_12_BIT;  // Sem histórico: precisão máxima
+}
+
+// Resolução para uma distância, sem histerese
+static DS18B20_RESOLUTION _resolution_for(const ds18b20_adaptive_config_t * cfg, float distance)
+{
+    if (distance < cfg->band_c[0])
+    {
+        return DS18B20_RESOLUTION_12_BIT;
+    }
+    if (distance < cfg->band_c[1])
+    {
+        return DS18B20_RESOLUTION_11_BIT;
+    }
+    if (distance < cfg->band_c[2])
+    {
+        return DS18B20_RESOLUTION_10_BIT;
+    }
+    return DS18B20_RESOLUTION_9_BIT;
+}
+
+DS18B20_RESOLUTION ds18b20_adaptive_update(ds18b20_adaptive_t * ctrl, float temp_c, int64_t timestamp_us)
+{
+    const ds18b20_adaptive_config_t * cfg = &ctrl->config;
+
+    if (!ctrl->has_ref)
+    {
+        ctrl->ref_temp = temp_c;
+        ctrl->ref_us = timestamp_us;
+        ctrl->has_ref = true;
+    }
+    else if (timestamp_us - ctrl->ref_us >= RATE_WINDOW_US)
+    {
+        float dt = (timestamp_us - ctrl->ref_us) / 1e6f;
+        float rate = (temp_c - ctrl->ref_temp) / dt;
+        ctrl->rate_c_per_s += cfg->rate_alpha * (rate - ctrl->rate_c_per_s);
+        ctrl->ref_temp = temp_c;
+        ctrl->ref_us = timestamp_us;
+    }
+
+    float distance = fabsf(temp_c - cfg->setpoint_c);
+    float projected = fabsf(temp_c + ctrl->rate_c_per_s * cfg->horizon_s - cfg->setpoint_c);
+    if (projected < distance)
+    {
+        distance = projected;
+    }
+
+    // Subir a precisão é imediato; baixar exige passar da banda + histerese
+    DS18B20_RESOLUTION target = _resolution_for(cfg, distance);
+    if (target < ctrl->resolution)
+    {
+        DS18B20_RESOLUTION relaxed = _resolution_for(cfg, distance - cfg->hysteresis_c);
+        target = (relaxed > target) ? relaxed : target;
+        if (target > ctrl->resolution)
+        {
+            target = ctrl->resolution;
+        }
+    }
+    ctrl->resolution = target;
+    return target;
+}
+
+uint32_t ds18b20_adaptive_period_ms(DS18B20_RESOLUTION resolution)
+{
+    uint32_t conv_ms = (ds18b20_conversion_time_us(resolution) + 999) / 1000 + READ_MARGIN_MS;
+    return (conv_ms + PERIOD_STEP_MS - 1) / PERIOD_STEP_MS * PERIOD_STEP_MS;
+}
@@ -0,0 +1,520 @@
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "ds18b20_group.h"
+#include "ds18b20_sched.h"
+#include "owb.h"
+
+static const char * TAG = "ds18b20_group";
+
+// Comandos (mesmos valores de ds18b20.c)
+#define DS18B20_FUNCTION_TEMP_CONVERT     0x44
+#define DS18B20_FUNCTION_SCRATCHPAD_WRITE 0x4E
+#define DS18B20_FUNCTION_SCRATCHPAD_COPY  0x48
+#define DS18B20_FUNCTION_EEPROM_RECALL    0xB8
+
+#define T_COPY_MS 10
+#define RECALL_MAX_POLLS 16
+
+
+// Acrescenta um DS18B20 ao grupo; false se não é DS18B20 ou o grupo está cheio.
+// Com `verify`, só entra se o scratchpad lido pelo ds18b20_init passou no CRC.
+static bool _add_sensor(ds18b20_group_t * group, OneWireBus_ROMCode rom, bool verify)
+{
+    char rom_s[OWB_ROM_CODE_STRING_LENGTH];
+    owb_string_from_rom_code(rom, rom_s, sizeof(rom_s));
+
+    if (rom.fields.family[0] != DS18B20_FAMILY_CODE)
+    {
+        ESP_LOGW(TAG, "Ignorando dispositivo %s (família 0x%02X)", rom_s, rom.fields.family[0]);
+        return false;
+    }
+    if (group->count == DS18B20_GROUP_MAX)
+    {
+        ESP_LOGW(TAG, "Grupo cheio: %s ignorado", rom_s);
+        return false;
+    }
+
+    DS18B20_Info * ds = &group->sensors[group->count];
+    ds18b20_init(ds, group->bus, rom);
+    if (verify && !ds->config.valid)
+    {
+        return false;
+    }
+    ESP_LOGI(TAG, "Sensor %u: %s (%d bits)", (unsigned)group->count, rom_s, ds->resolution);
+    group->count++;
+    return true;
+}
+
+size_t ds18b20_group_init(ds18b20_group_t * group, const OneWireBus * bus)
+{
+    memset(group, 0, sizeof(*group));
+    group->bus = bus;
+
+    OneWireBus_SearchState state = {0};
+    bool found = false;
+    owb_search_first(bus, &state, &found);
+    while (found)
+    {
+        _add_sensor(group, state.rom_code, false);
+        owb_search_next(bus, &state, &found);
+    }
+
+    return group->count;
+}
+
+// Verificação do cache: o ds18b20_init já lê o scratchpad (com CRC) para
+// saber a resolução, e essa leitura só passa se o sensor estiver lá. Então
+// confirmar um sensor conhecido não custa nenhum slot além da própria inicialização.
+static owb_status _verify_sensor(const OneWireBus * bus, OneWireBus_ROMCode rom, bool * is_present, void * ctx)
+{
+    ds18b20_group_t * group = (ds18b20_group_t *)ctx;
+    if (rom.fields.family[0] != DS18B20_FAMILY_CODE)
+    {
+        return owb_verify_rom(bus, rom, is_present);
+    }
+    *is_present = _add_sensor(group, rom, true);
+    return OWB_STATUS_OK;
+}
+
+size_t ds18b20_group_init_cached(ds18b20_group_t * group, owb_registry_t * registry)
+{
+    memset(group, 0, sizeof(*group));
+    group->bus = registry->bus;
+    group->registry = registry;
+
+    // Sensores conhecidos entram no grupo durante a verificação
+    owb_registry_set_verifier(registry, _verify_sensor, group);
+    size_t present = 0;
+    if (owb_registry_refresh(registry, &present) != OWB_STATUS_OK)
+    {
+        ESP_LOGE(TAG, "Falha ao atualizar o cache de ROMs");
+    }
+    owb_registry_set_verifier(registry, NULL, NULL);
+
+    // Houve busca completa (cache vazio, hot-plug ou nenhum conhecido respondeu)
+    if (group->count == 0)
+    {
+        for (size_t i = 0; i < registry->count; i++)
+        {
+            if (registry->entries[i].present)
+            {
+                _add_sensor(group, registry->entries[i].rom_code, false);
+            }
+        }
+    }
+    ESP_LOGI(TAG, "%u sensor(es) do cache (%lu buscas completas, %lu verificações)", (unsigned)group->count,
+             (unsigned long)registry->enumerations, (unsigned long)registry->verifications);
+
+    return group->count;
+}
+
+static int _index_of(const ds18b20_group_t * group, const OneWireBus_ROMCode * rom)
+{
+    for (size_t i = 0; i < group->count; i++)
+    {
+        if (memcmp(group->sensors[i].rom_code.bytes, rom->bytes, sizeof(rom->bytes)) == 0)
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static bool _is_absent(const ds18b20_group_t * group, size_t index)
+{
+    return (group->absent & (1UL << index)) != 0;
+}
+
+// Sensor que entrou depois: mesma configuração de leitura e de TH/TL/resolução do primeiro
+static void _adopt_settings(ds18b20_group_t * group, DS18B20_Info * ds)
+{
+    const DS18B20_Info * ref = &group->sensors[0];
+    ds18b20_use_crc(ds, ref->use_crc);
+    ds18b20_use_fast_read(ds, ref->fast_full_every, ref->fast_max_rate);
+    if (ref->resolution != DS18B20_RESOLUTION_INVALID)
+    {
+        ds18b20_config_set_resolution(ds, ref->resolution);
+    }
+    if (group->alarm_mode)
+    {
+        ds18b20_config_set_alarms(ds, (int8_t)ref->config.trigger_high, (int8_t)ref->config.trigger_low);
+    }
+    ds18b20_config_write(ds);
+}
+
+size_t ds18b20_group_rescan(ds18b20_group_t * group)
+{
+    if (!group->registry || !owb_registry_hotplug_pending(group->registry))
+    {
+        return 0;
+    }
+    if (owb_registry_enumerate(group->registry) != OWB_STATUS_OK)
+    {
+        ESP_LOGE(TAG, "Falha na busca depois do hot-plug");
+        return 0;
+    }
+
+    // Quem não apareceu na busca fica marcado, sem perder a posição
+    uint32_t absent = 0;
+    for (size_t i = 0; i < group->count; i++)
+    {
+        const owb_registry_entry_t * entry = owb_registry_find(group->registry, group->sensors[i].rom_code);
+        if (!entry || !entry->present)
+        {
+            absent |= (1UL << i);
+        }
+    }
+
+    size_t added = 0;
+    for (size_t i = 0; i < group->registry->count; i++)
+    {
+        if (!group->registry->entries[i].present)
+        {
+            continue;  // Barramento vazio: o registro guarda os conhecidos, mas ninguém respondeu
+        }
+        const OneWireBus_ROMCode * rom = &group->registry->entries[i].rom_code;
+        int known = _index_of(group, rom);
+        if (known >= 0)
+        {
+            DS18B20_Info * ds = &group->sensors[known];
+            if (_is_absent(group, known))
+            {
+                // Voltou com a EEPROM no scratchpad: reescreve o que não estava
+                // gravado nela e o que mudou enquanto estava fora
+                if (!ds->config.eeprom_synced)
+                {
+                    ds->config.dirty = true;
+                }
+                ds18b20_config_write(ds);
+            }
+            continue;
+        }
+        size_t index = group->count;
+        if (_add_sensor(group, *rom, false))
+        {
+            if (index > 0)
+            {
+                _adopt_settings(group, &group->sensors[index]);
+            }
+            added++;
+        }
+    }
+
+    if (absent != group->absent)
+    {
+        ESP_LOGW(TAG, "🔌 Sensores ausentes: 0x%08lx (antes 0x%08lx)", (unsigned long)absent,
+                 (unsigned long)group->absent);
+    }
+    group->absent = absent;
+    if (added)
+    {
+        ESP_LOGI(TAG, "🔌 %u sensor(es) novo(s) no barramento", (unsigned)added);
+    }
+    return added;
+}
+
+void ds18b20_group_use_crc(ds18b20_group_t * group, bool use_crc)
+{
+    for (size_t i = 0; i < group->count; i++)
+    {
+        ds18b20_use_crc(&group->sensors[i], use_crc);
+    }
+}
+
+void ds18b20_group_use_fast_read(ds18b20_group_t * group, uint8_t full_every, float max_rate_c_per_s)
+{
+    for (size_t i = 0; i < group->count; i++)
+    {
+        ds18b20_use_fast_read(&group->sensors[i], full_every, max_rate_c_per_s);
+    }
+}
+
+// Reset + SKIP ROM: o próximo comando vale para todos os sensores
+static bool _broadcast(const ds18b20_group_t * group)
+{
+    bool present = false;
+    if (group->count == 0 || owb_reset(group->bus, &present) != OWB_STATUS_OK)
+    {
+        return false;
+    }
+    // Barramento vazio seguido de presença: possível troca de sensores
+    owb_registry_note_reset(group->registry, present);
+    if (!present)
+    {
+        return false;
+    }
+    owb_write_byte(group->bus, OWB_ROM_SKIP);
+    return true;
+}
+
+// Configuração comum a todos os sensores presentes (espelhos válidos e com o
+// mesmo conteúdo pendente), ou NULL se diferem ou não há nenhum presente
+static const DS18B20_Config * _uniform_config(const ds18b20_group_t * group)
+{
+    const DS18B20_Config * first = NULL;
+    for (size_t i = 0; i < group->count; i++)
+    {
+        if (_is_absent(group, i))
+        {
+            continue;
+        }
+        const DS18B20_Config * c = &group->sensors[i].config;
+        if (!first)
+        {
+            first = c;
+        }
+        if (!c->valid || c->trigger_high != first->trigger_high ||
+            c->trigger_low != first->trigger_low || c->configuration != first->configuration)
+        {
+            return NULL;
+        }
+    }
+    return first;
+}
+
+bool ds18b20_group_write_config(ds18b20_group_t * group)
+{
+    // Ausentes ficam com a configuração pendente até voltarem (ds18b20_group_rescan)
+    bool dirty = false;
+    for (size_t i = 0; i < group->count; i++)
+    {
+        dirty |= !_is_absent(group, i) && group->sensors[i].config.dirty;
+    }
+    if (!dirty)
+    {
+        return true;  // Nada pendente
+    }
+
+    // Mesmo TH/TL/config em todos: um único WRITE SCRATCHPAD broadcast,
+    // custo constante no número de sensores
+    const DS18B20_Config * c = _uniform_config(group);
+    if (c && _broadcast(group))
+    {
+        uint8_t bytes[3] = { c->trigger_high, c->trigger_low, c->configuration };
+        owb_write_byte(group->bus, DS18B20_FUNCTION_SCRATCHPAD_WRITE);
+        owb_write_bytes(group->bus, bytes, sizeof(bytes));
+        DS18B20_RESOLUTION resolution = ((c->configuration >> 5) & 0x03) + DS18B20_RESOLUTION_9_BIT;
+        for (size_t i = 0; i < group->count; i++)
+        {
+            if (_is_absent(group, i))
+            {
+                continue;
+            }
+            DS18B20_Info * ds = &group->sensors[i];
+            ds->config.dirty = false;
+            ds->config.eeprom_synced = false;
+            ds->resolution = resolution;
+        }
+        return true;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < group->count; i++)
+    {
+        if (!_is_absent(group, i))
+        {
+            ok &= ds18b20_config_write(&group->sensors[i]);
+        }
+    }
+    return ok;
+}
+
+bool ds18b20_group_set_resolution(ds18b20_group_t * group, DS18B20_RESOLUTION resolution)
+{
+    for (size_t i = 0; i < group->count; i++)
+    {
+        ds18b20_config_set_resolution(&group->sensors[i], resolution);
+    }
+    return ds18b20_group_write_config(group);
+}
+
+bool ds18b20_group_use_alarm(ds18b20_group_t * group, int8_t high_c, int8_t low_c)
+{
+    for (size_t i = 0; i < group->count; i++)
+    {
+        ds18b20_config_set_alarms(&group->sensors[i], high_c, low_c);
+    }
+    group->alarm_mode = ds18b20_group_write_config(group);
+    return group->alarm_mode;
+}
+
+void ds18b20_group_set_always_read(ds18b20_group_t * group, size_t index, bool always)
+{
+    if (index >= DS18B20_GROUP_MAX)
+    {
+        return;
+    }
+    if (always)
+    {
+        group->always_read |= (1UL << index);
+    }
+    else
+    {
+        group->always_read &= ~(1UL << index);
+    }
+}
+
+size_t ds18b20_group_alarm_search(ds18b20_group_t * group, bool * alarmed)
+{
+    memset(alarmed, 0, group->count * sizeof(bool));
+    group->alarm_searches++;
+
+    // Só quem está em alarme participa da busca: sem alarmes, ela termina
+    // no primeiro par de bits (1, 1), em vez de N leituras de scratchpad
+    size_t hits = 0;
+    OneWireBus_SearchState state = {0};
+    bool found = false;
+    owb_search_alarm_first(group->bus, &state, &found);
+    while (found)
+    {
+        int i = _index_of(group, &state.rom_code);
+        if (i >= 0 && !alarmed[i])
+        {
+            alarmed[i] = true;
+            hits++;
+        }
+        else if (i < 0)
+        {
+            char rom_s[OWB_ROM_CODE_STRING_LENGTH];
+            owb_string_from_rom_code(state.rom_code, rom_s, sizeof(rom_s));
+            ESP_LOGW(TAG, "Alarme de dispositivo fora do grupo: %s", rom_s);
+        }
+        owb_search_alarm_next(group->bus, &state, &found);
+    }
+
+    group->alarm_hits += hits;
+    return hits;
+}
+
+bool ds18b20_group_save_config(ds18b20_group_t * group)
+{
+    bool pending = false;
+    for (size_t i = 0; i < group->count; i++)
+    {
+        if (_is_absent(group, i))
+        {
+            continue;
+        }
+        // Escreve o que estiver pendente antes de copiar para a EEPROM
+        if (!ds18b20_config_write(&group->sensors[i]))
+        {
+            return false;
+        }
+        pending |= !group->sensors[i].config.eeprom_synced;
+    }
+    if (!pending)
+    {
+        return true;  // Nada novo: poupa ciclos de gravação da EEPROM
+    }
+    if (!_broadcast(group))
+    {
+        return false;
+    }
+
+    owb_write_byte(group->bus, DS18B20_FUNCTION_SCRATCHPAD_COPY);
+    owb_set_strong_pullup(group->bus, true);
+    vTaskDelay(pdMS_TO_TICKS(T_COPY_MS) + 1);
+    owb_set_strong_pullup(group->bus, false);
+
+    for (size_t i = 0; i < group->count; i++)
+    {
+        if (!_is_absent(group, i))
+        {
+            group->sensors[i].config.eeprom_synced = true;
+        }
+    }
+    ESP_LOGI(TAG, "Configuração gravada na EEPROM de %u sensores", (unsigned)group->count);
+    return true;
+}
+
+bool ds18b20_group_recall(ds18b20_group_t * group)
+{
+    if (!_broadcast(group))
+    {
+        return false;
+    }
+
+    // Com vários sensores o read slot só volta a 1 quando todos terminaram
+    owb_write_byte(group->bus, DS18B20_FUNCTION_EEPROM_RECALL);
+    for (int i = 0; i < RECALL_MAX_POLLS; i++)
+    {
+        uint8_t bit = 0;
+        if (owb_read_bit(group->bus, &bit) == OWB_STATUS_OK && bit)
+        {
+            break;
+        }
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < group->count; i++)
+    {
+        if (_is_absent(group, i))
+        {
+            continue;
+        }
+        DS18B20_Info * ds = &group->sensors[i];
+        ds->config.dirty = false;
+        if (!ds->config.eeprom_synced)
+        {
+            // EEPROM desconhecida: só este sensor precisa de uma leitura
+            ds->config.valid = false;
+        }
+        ds->resolution = ds18b20_read_resolution(ds);
+        ds->config.eeprom_synced = ds->config.valid;
+        ok &= ds->resolution != DS18B20_RESOLUTION_INVALID;
+    }
+    return ok;
+}
+
+bool ds18b20_group_convert(const ds18b20_group_t * group)
+{
+    // SKIP ROM: todos os sensores começam a converter no mesmo instante
+    if (!_broadcast(group))
+    {
+        return false;
+    }
+    owb_write_byte(group->bus, DS18B20_FUNCTION_TEMP_CONVERT);
+    return true;
+}
+
+uint32_t ds18b20_group_conversion_time_us(const ds18b20_group_t * group)
+{
+    uint32_t worst = 0;
+    for (size_t i = 0; i < group->count; i++)
+    {
+        if (_is_absent(group, i))
+        {
+            continue;
+        }
+        uint32_t t = ds18b20_conversion_time_us(group->sensors[i].resolution);
+        if (t > worst)
+        {
+            worst = t;
+        }
+    }
+    return worst;
+}
+
+DS18B20_ERROR ds18b20_group_read(ds18b20_group_t * group, float * temperatures, DS18B20_ERROR * errors)
+{
+    DS18B20_ERROR result = DS18B20_OK;
+    for (size_t i = 0; i < group->count; i++)
+    {
+        // MATCH ROM + READ SCRATCHPAD: só o sensor i responde
+        DS18B20_ERROR err = _is_absent(group, i) ? DS18B20_ERROR_DEVICE
+                                                 : ds18b20_read_temp_fast(&group->sensors[i], &temperatures[i]);
+        if (errors)
+        {
+            errors[i] = err;
+        }
+        if (err != DS18B20_OK)
+        {
+            result = err;
+        }
+    }
+    return result;
+}
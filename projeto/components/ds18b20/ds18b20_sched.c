@@ -0,0 +1,388 @@
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+
+#include "ds18b20_sched.h"
+#include "owb.h"
+
+static const char * TAG = "ds18b20_sched";
+
+// Tempo máximo de conversão a 12 bits (em µs); cada bit a menos divide por 2
+#define T_CONV_12BIT_US 750000
+#define DEFAULT_POLL_INTERVAL_MS 10
+#define SCHED_TASK_STACK 3072
+
+typedef struct
+{
+    DS18B20_Info * sensor;           // Modo de um sensor só
+    ds18b20_group_t * group;         // Modo grupo (sensor == NULL)
+    const OneWireBus * bus;
+    ds18b20_sched_config_t config;
+    esp_timer_handle_t timer;
+    TaskHandle_t task;
+    volatile bool stop;
+    volatile bool trigger;
+    volatile uint32_t period_ms;                 // Pode mudar com o agendador rodando
+    volatile DS18B20_RESOLUTION new_resolution;  // Aplicada no início do próximo ciclo
+    uint32_t seq;
+    ds18b20_sched_stats_t stats;
+} ds18b20_sched_t;
+
+static ds18b20_sched_t s_sched;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+
+// O timer só acorda a task: todo o tráfego 1-Wire fica fora do esp_timer
+static void _timer_cb(void * arg)
+{
+    TaskHandle_t task = s_sched.task;
+    if (task != NULL)
+    {
+        xTaskNotifyGive(task);
+    }
+}
+
+// Dorme até `deadline_us` (ou até um trigger/stop acordar a task antes)
+static void _sleep_until(int64_t deadline_us)
+{
+    int64_t delay_us = deadline_us - esp_timer_get_time();
+    if (delay_us <= 0)
+    {
+        return;
+    }
+    esp_timer_stop(s_sched.timer);
+    esp_timer_start_once(s_sched.timer, (uint64_t)delay_us);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+uint32_t ds18b20_conversion_time_us(DS18B20_RESOLUTION resolution)
+{
+    int shift = DS18B20_RESOLUTION_12_BIT - resolution;
+    if (shift < 0 || shift > 3)
+    {
+        shift = 0;  // Resolução desconhecida: pior caso
+    }
+    return T_CONV_12BIT_US >> shift;
+}
+
+// Espera a conversão iniciada em `start_us`
+static void _wait_conversion(int64_t start_us)
+{
+    const OneWireBus * bus = s_sched.bus;
+    uint32_t conv_us = s_sched.group ? ds18b20_group_conversion_time_us(s_sched.group)
+                                     : ds18b20_conversion_time_us(s_sched.sensor->resolution);
+    int64_t deadline_us = start_us + conv_us;
+
+    // Com alimentação parasita o sensor não responde aos read slots
+    // enquanto converte (e o pull-up forte precisa ficar ligado)
+    if (s_sched.config.wait_mode == DS18B20_WAIT_POLL && !bus->use_parasitic_power)
+    {
+        int64_t poll_us = (s_sched.config.poll_interval_ms ? s_sched.config.poll_interval_ms
+                                                           : DEFAULT_POLL_INTERVAL_MS) * 1000LL;
+        while (!s_sched.stop)
+        {
+            int64_t next_us = esp_timer_get_time() + poll_us;
+            _sleep_until(next_us < deadline_us ? next_us : deadline_us);
+
+            // Read slot: 0 enquanto converte, 1 quando terminou. Com vários
+            // sensores o barramento é um E lógico: 1 só quando todos terminaram.
+            uint8_t bit = 0;
+            if (owb_read_bit(bus, &bit) == OWB_STATUS_OK && bit)
+            {
+                return;
+            }
+            if (esp_timer_get_time() >= deadline_us)
+            {
+                return;  // Passou do máximo: lê mesmo assim, o scratchpad decide
+            }
+        }
+        return;
+    }
+
+    while (!s_sched.stop && esp_timer_get_time() < deadline_us)
+    {
+        _sleep_until(deadline_us);
+    }
+}
+
+static void _deliver(const ds18b20_reading_t * reading)
+{
+    bool dropped = false;
+    if (s_sched.config.queue && xQueueSend(s_sched.config.queue, reading, 0) != pdTRUE)
+    {
+        dropped = true;
+    }
+
+    portENTER_CRITICAL(&s_stats_lock);
+    ds18b20_sched_stats_t * st = &s_sched.stats;
+    st->readings++;
+    if (reading->error != DS18B20_OK)
+    {
+        st->errors++;
+    }
+    else
+    {
+        st->last_conversion_us = reading->conversion_us;
+        if (st->min_conversion_us == 0 || reading->conversion_us < st->min_conversion_us)
+        {
+            st->min_conversion_us = reading->conversion_us;
+        }
+        if (reading->conversion_us > st->max_conversion_us)
+        {
+            st->max_conversion_us = reading->conversion_us;
+        }
+    }
+    if (dropped)
+    {
+        st->dropped++;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    if (s_sched.config.cb)
+    {
+        s_sched.config.cb(reading, s_sched.config.ctx);
+    }
+}
+
+// Um ciclo completo: CONVERT T, espera sem ocupar a CPU, lê os scratchpads
+static void _run_cycle(void)
+{
+    const OneWireBus * bus = s_sched.bus;
+
+    // Sensores recolocados no barramento: nova busca antes da conversão
+    // (só com grupo criado a partir do cache de ROMs)
+    if (s_sched.group)
+    {
+        ds18b20_group_rescan(s_sched.group);
+    }
+
+    size_t count = s_sched.group ? s_sched.group->count : 1;
+    uint32_t seq = ++s_sched.seq;
+    uint32_t conversion_us = 0;
+
+    portENTER_CRITICAL(&s_stats_lock);
+    s_sched.stats.cycles++;
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    // Troca de resolução pedida por outra task: só aqui o barramento é nosso.
+    // ds18b20_set_resolution não vai ao barramento se já estiver nela.
+    DS18B20_RESOLUTION resolution = s_sched.new_resolution;
+    if (resolution != DS18B20_RESOLUTION_INVALID)
+    {
+        s_sched.new_resolution = DS18B20_RESOLUTION_INVALID;
+        if (s_sched.group)
+        {
+            ds18b20_group_set_resolution(s_sched.group, resolution);
+        }
+        else
+        {
+            ds18b20_set_resolution(s_sched.sensor, resolution);
+        }
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    bool started = s_sched.group ? ds18b20_group_convert(s_sched.group) : ds18b20_convert(s_sched.sensor);
+    if (started)
+    {
+        if (bus->use_parasitic_power)
+        {
+            owb_set_strong_pullup(bus, true);
+        }
+        _wait_conversion(start_us);
+        if (bus->use_parasitic_power)
+        {
+            owb_set_strong_pullup(bus, false);
+        }
+        conversion_us = (uint32_t)(esp_timer_get_time() - start_us);
+    }
+    else
+    {
+        ESP_LOGE(TAG, "Falha ao iniciar a conversão");
+    }
+
+    // Modo alarme: uma busca 0xEC diz quem passou dos limites; só esses
+    // (e os marcados como always_read) são lidos
+    bool alarm_mode = started && s_sched.group && s_sched.group->alarm_mode;
+    bool alarmed[DS18B20_GROUP_MAX] = {0};
+    if (alarm_mode)
+    {
+        ds18b20_group_alarm_search(s_sched.group, alarmed);
+    }
+
+    for (size_t i = 0; i < count && !s_sched.stop; i++)
+    {
+        DS18B20_Info * sensor = s_sched.group ? &s_sched.group->sensors[i] : s_sched.sensor;
+        ds18b20_reading_t reading = {
+            .seq = seq,
+            .index = (uint8_t)i,
+            .error = DS18B20_ERROR_DEVICE,
+            .conversion_us = conversion_us,
+            .alarm = alarmed[i],
+        };
+        bool always = s_sched.group && (s_sched.group->always_read & (1UL << i));
+        bool absent = s_sched.group && (s_sched.group->absent & (1UL << i));
+        if ((alarm_mode && !alarmed[i] && !always) || (absent && !always))
+        {
+            portENTER_CRITICAL(&s_stats_lock);
+            s_sched.stats.skipped++;
+            portEXIT_CRITICAL(&s_stats_lock);
+            continue;
+        }
+        // Sonda fora do barramento: quem depende dela recebe o erro, sem tráfego
+        if (started && !absent)
+        {
+            // Em alarme: leitura completa com CRC, nada de atalho
+            reading.error = reading.alarm ? ds18b20_read_temp_full(sensor, &reading.temperature)
+                                          : ds18b20_read_temp_fast(sensor, &reading.temperature);
+        }
+        reading.timestamp_us = esp_timer_get_time();
+        _deliver(&reading);
+    }
+}
+
+static void _sched_task(void * arg)
+{
+    int64_t last_start_us = 0;
+    bool first = true;
+
+    while (!s_sched.stop)
+    {
+        int64_t period_us = s_sched.period_ms * 1000LL;
+        int64_t now = esp_timer_get_time();
+        int64_t next_start_us = first ? now : last_start_us + period_us;
+        bool due = s_sched.trigger || (period_us > 0 && now >= next_start_us);
+        if (!due)
+        {
+            if (period_us > 0)
+            {
+                _sleep_until(next_start_us);
+            }
+            else
+            {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+            continue;
+        }
+
+        // Mantém a grade de períodos; depois de um trigger ou de um atraso
+        // maior que um período, reancora em vez de disparar em rajada
+        bool reanchor = first || s_sched.trigger || now - next_start_us >= period_us;
+        last_start_us = reanchor ? now : next_start_us;
+        first = false;
+        s_sched.trigger = false;
+        _run_cycle();
+    }
+
+    esp_timer_stop(s_sched.timer);
+    s_sched.task = NULL;
+    vTaskDelete(NULL);
+}
+
+
+static esp_err_t _start(DS18B20_Info * sensor, ds18b20_group_t * group,
+                        const ds18b20_sched_config_t * config)
+{
+    if (s_sched.task != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    memset(&s_sched, 0, sizeof(s_sched));
+    s_sched.sensor = sensor;
+    s_sched.group = group;
+    s_sched.bus = group ? group->bus : sensor->bus;
+    s_sched.config = *config;
+    s_sched.period_ms = config->period_ms;
+    s_sched.new_resolution = DS18B20_RESOLUTION_INVALID;
+
+    // O timer existe antes da task: o primeiro ciclo pode começar na hora
+    const esp_timer_create_args_t timer_args = {
+        .callback = _timer_cb,
+        .name = "ds18b20_conv",
+    };
+    esp_err_t err = esp_timer_create(&timer_args, &s_sched.timer);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+
+    if (xTaskCreate(_sched_task, "ds18b20_sched", SCHED_TASK_STACK, NULL, config->task_priority,
+                    &s_sched.task) != pdPASS)
+    {
+        s_sched.task = NULL;
+        esp_timer_delete(s_sched.timer);
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "Agendador iniciado (%u sensor(es), %lu ms, %s)", (unsigned)(group ? group->count : 1),
+             (unsigned long)config->period_ms, config->wait_mode == DS18B20_WAIT_POLL ? "poll" : "timer");
+    return ESP_OK;
+}
+
+esp_err_t ds18b20_sched_start(DS18B20_Info * sensor, const ds18b20_sched_config_t * config)
+{
+    if (!sensor || !config || !sensor->init)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return _start(sensor, NULL, config);
+}
+
+esp_err_t ds18b20_sched_start_group(ds18b20_group_t * group, const ds18b20_sched_config_t * config)
+{
+    if (!group || !config || group->count == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return _start(NULL, group, config);
+}
+
+void ds18b20_sched_stop(void)
+{
+    if (s_sched.task == NULL)
+    {
+        return;
+    }
+
+    s_sched.stop = true;
+    xTaskNotifyGive(s_sched.task);
+    while (s_sched.task != NULL)
+    {
+        vTaskDelay(pdMS_TO_TICKS(DEFAULT_POLL_INTERVAL_MS));
+    }
+    esp_timer_delete(s_sched.timer);
+    s_sched.timer = NULL;
+}
+
+void ds18b20_sched_trigger(void)
+{
+    if (s_sched.task != NULL)
+    {
+        s_sched.trigger = true;
+        xTaskNotifyGive(s_sched.task);
+    }
+}
+
+void ds18b20_sched_set_period(uint32_t period_ms)
+{
+    s_sched.period_ms = period_ms;
+    if (s_sched.task != NULL)
+    {
+        xTaskNotifyGive(s_sched.task);  // Reavalia o próximo início com o novo período
+    }
+}
+
+void ds18b20_sched_set_resolution(DS18B20_RESOLUTION resolution)
+{
+    s_sched.new_resolution = resolution;
+}
+
+void ds18b20_sched_get_stats(ds18b20_sched_stats_t * stats)
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_sched.stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
@@ -26,6 +26,17 @@ typedef enum
     DS18B20_RESOLUTION_12_BIT  = 12, 
 } DS18B20_RESOLUTION;
 
+// Espelho dos 3 bytes de configuração do scratchpad (TH, TL, config)
+typedef struct
+{
+    uint8_t trigger_high;
+    uint8_t trigger_low;
+    uint8_t configuration;
+    bool valid;                    // Conteúdo conhecido (lido ou escrito por nós)
+    bool dirty;                    // Alterado aqui, ainda não escrito no sensor
+    bool eeprom_synced;            // Igual ao que está na EEPROM do sensor
+} DS18B20_Config;
+
 typedef struct
 {
     bool init;                     
@@ -34,6 +45,21 @@ typedef struct
     const OneWireBus * bus;        
     OneWireBus_ROMCode rom_code;   
     DS18B20_RESOLUTION resolution; 
+    DS18B20_Config config;
+    uint32_t power_on_restores;    // Resets do sensor detectados e corrigidos
+    bool overdrive;                // Acessado em overdrive (bus->use_overdrive e o sensor respondeu)
+    uint32_t overdrive_fallbacks;  // Vezes que o overdrive falhou e foi desligado
+
+    // Leitura rápida (ds18b20_read_temp_fast)
+    uint8_t fast_full_every;       // A cada N leituras rápidas, uma completa com CRC (0 = desligada)
+    uint8_t fast_since_full;
+    float fast_max_rate;           // Variação plausível em °C/s
+    bool last_valid;
+    float last_temp;
+    int64_t last_temp_us;
+    uint32_t fast_reads;
+    uint32_t full_reads;
+    uint32_t implausible;          // Leituras rápidas rejeitadas (confirmadas por leitura completa)
 } DS18B20_Info;
 
 DS18B20_Info * ds18b20_malloc(void);
@@ -48,6 +74,20 @@ void ds18b20_use_crc(DS18B20_Info * ds18b20_info, bool use_crc);
 
 bool ds18b20_set_resolution(DS18B20_Info * ds18b20_info, DS18B20_RESOLUTION resolution);
 
+// Configuração em lote: os setters só mexem no espelho; ds18b20_config_write
+// manda tudo num único WRITE SCRATCHPAD, e só se algo mudou
+void ds18b20_config_set_resolution(DS18B20_Info * ds18b20_info, DS18B20_RESOLUTION resolution);
+
+void ds18b20_config_set_alarms(DS18B20_Info * ds18b20_info, int8_t high_c, int8_t low_c);
+
+bool ds18b20_config_write(DS18B20_Info * ds18b20_info);
+
+// COPY SCRATCHPAD: grava a configuração na EEPROM (só se for diferente)
+bool ds18b20_config_save(DS18B20_Info * ds18b20_info);
+
+// RECALL E²: recarrega a configuração da EEPROM para o scratchpad
+bool ds18b20_config_recall(DS18B20_Info * ds18b20_info);
+
 DS18B20_RESOLUTION ds18b20_read_resolution(DS18B20_Info * ds18b20_info);
 
 OneWireBus_ROMCode ds18b20_read_rom(DS18B20_Info * ds18b20_info);
@@ -58,9 +98,19 @@ void ds18b20_convert_all(const OneWireBus * bus);
 
 float ds18b20_wait_for_conversion(const DS18B20_Info * ds18b20_info);
 
-DS18B20_ERROR ds18b20_read_temp(const DS18B20_Info * ds18b20_info, float * value);
+DS18B20_ERROR ds18b20_read_temp(DS18B20_Info * ds18b20_info, float * value);
+
+// Leitura rápida: só os 2 bytes de temperatura, seguidos de um reset. A cada
+// `full_every` leituras (ou se o valor variar mais que `max_rate_c_per_s`)
+// faz uma leitura completa com CRC. full_every = 0 desliga o modo rápido.
+void ds18b20_use_fast_read(DS18B20_Info * ds18b20_info, uint8_t full_every, float max_rate_c_per_s);
+
+DS18B20_ERROR ds18b20_read_temp_fast(DS18B20_Info * ds18b20_info, float * value);
+
+// Leitura completa com CRC, que também vira a referência da leitura rápida
+DS18B20_ERROR ds18b20_read_temp_full(DS18B20_Info * ds18b20_info, float * value);
 
-DS18B20_ERROR ds18b20_convert_and_read_temp(const DS18B20_Info * ds18b20_info, float * value);
+DS18B20_ERROR ds18b20_convert_and_read_temp(DS18B20_Info * ds18b20_info, float * value);
 
 DS18B20_ERROR ds18b20_check_for_parasite_power(const OneWireBus * bus, bool * present);
 
@@ -0,0 +1,52 @@
+#ifndef DS18B20_ADAPTIVE_H
+#define DS18B20_ADAPTIVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ds18b20.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------
+// Resolução adaptativa
+// Longe do setpoint meio grau de erro não muda a decisão de controle, então
+// 9 bits (94 ms) bastam e dá para amostrar a ~10 Hz. Perto dele usa 12 bits.
+// A distância considerada é a menor entre a atual e a projetada pela
+// tendência (`horizon_s` à frente): aproximar-se rápido já sobe a precisão.
+// ----------------------
+
+typedef struct
+{
+    float setpoint_c;
+    float band_c[3];        // Distâncias (crescentes) abaixo das quais usar 12, 11 e 10 bits; acima: 9 bits
+    float hysteresis_c;     // Folga para voltar a uma resolução menor
+    float horizon_s;        // Projeção da tendência
+    float rate_alpha;       // Suavização da taxa (0..1, maior = mais rápida)
+} ds18b20_adaptive_config_t;
+
+typedef struct
+{
+    ds18b20_adaptive_config_t config;
+    DS18B20_RESOLUTION resolution;
+    float rate_c_per_s;     // Tendência suavizada
+    float ref_temp;         // Início da janela de cálculo da taxa
+    int64_t ref_us;
+    bool has_ref;
+} ds18b20_adaptive_t;
+
+void ds18b20_adaptive_init(ds18b20_adaptive_t * ctrl, const ds18b20_adaptive_config_t * config);
+
+// 📈 Nova leitura; retorna a resolução a usar a partir da próxima conversão
+DS18B20_RESOLUTION ds18b20_adaptive_update(ds18b20_adaptive_t * ctrl, float temp_c, int64_t timestamp_us);
+
+// ⏱ Período de amostragem para a resolução (conversão + leitura, arredondado
+// para múltiplos de 50 ms: 100, 200, 400 e 800 ms)
+uint32_t ds18b20_adaptive_period_ms(DS18B20_RESOLUTION resolution);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DS18B20_ADAPTIVE_H
@@ -0,0 +1,107 @@
+#ifndef DS18B20_GROUP_H
+#define DS18B20_GROUP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ds18b20.h"
+#include "owb_registry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------
+// Grupo de sensores num mesmo barramento
+// Todos convertem juntos (SKIP ROM + CONVERT T) e cada scratchpad é lido
+// depois com MATCH ROM: uma varredura de N sensores custa um período de
+// conversão + N leituras curtas, em vez de N × 750 ms.
+// ----------------------
+
+#define DS18B20_GROUP_MAX 16
+#define DS18B20_FAMILY_CODE 0x28
+
+typedef struct
+{
+    const OneWireBus * bus;
+    DS18B20_Info sensors[DS18B20_GROUP_MAX];
+    size_t count;
+    uint32_t absent;               // Bit i: sensor i sumiu na última busca (não é lido nem configurado)
+
+    // Modo alarme (ds18b20_group_use_alarm)
+    bool alarm_mode;
+    uint32_t always_read;          // Bit i: sensor i é lido em todo ciclo, com ou sem alarme
+    uint32_t alarm_searches;
+    uint32_t alarm_hits;           // Sensores encontrados em alarme (soma de todas as buscas)
+
+    // Cache de ROMs (ds18b20_group_init_cached); NULL com ds18b20_group_init
+    owb_registry_t * registry;
+} ds18b20_group_t;
+
+// 🔍 Procura os DS18B20 do barramento (owb_search_first/next) e lê a
+// resolução de cada um. Retorna quantos foram encontrados.
+size_t ds18b20_group_init(ds18b20_group_t * group, const OneWireBus * bus);
+
+// 💾 Como ds18b20_group_init, mas a partir do cache de ROMs: com sensores já
+// conhecidos (NVS) o boot só verifica cada um (owb_registry_refresh), sem
+// a busca completa. O registro precisa viver tanto quanto o grupo.
+size_t ds18b20_group_init_cached(ds18b20_group_t * group, owb_registry_t * registry);
+
+// 🔌 Se houve indício de hot-plug (presença depois de um barramento vazio),
+// refaz a busca e acrescenta os sensores novos, com a configuração do
+// primeiro sensor do grupo. Sensores que não estão mais no barramento ficam
+// marcados em `absent` e mantêm a posição: o índice de cada sensor continua
+// apontando para a mesma sonda, e uma sonda que volta reocupa o seu lugar.
+// Retorna quantos entraram. Sem registro, não faz nada.
+size_t ds18b20_group_rescan(ds18b20_group_t * group);
+
+void ds18b20_group_use_crc(ds18b20_group_t * group, bool use_crc);
+
+// ⚡ Leitura rápida (2 bytes) em todos; ver ds18b20_use_fast_read
+void ds18b20_group_use_fast_read(ds18b20_group_t * group, uint8_t full_every, float max_rate_c_per_s);
+
+// ⚙️ Mesma resolução para todos; false se algum sensor recusou. Usa o
+// espelho de configuração: sem leitura prévia e, se os sensores têm o mesmo
+// TH/TL, um só WRITE SCRATCHPAD broadcast. Não grava a EEPROM.
+bool ds18b20_group_set_resolution(ds18b20_group_t * group, DS18B20_RESOLUTION resolution);
+
+// ✏️ Escreve as configurações pendentes (ds18b20_config_set_*) de todos os
+// sensores: broadcast se forem iguais, um WRITE SCRATCHPAD por sensor se não
+bool ds18b20_group_write_config(ds18b20_group_t * group);
+
+// 🚨 Modo alarme: programa TH/TL (°C inteiros) em todos os sensores e liga
+// o modo. O sensor fica em alarme depois de uma conversão com T >= TH ou
+// T <= TL (só a parte inteira é comparada). Para limites por sensor, use
+// ds18b20_config_set_alarms + ds18b20_group_write_config.
+bool ds18b20_group_use_alarm(ds18b20_group_t * group, int8_t high_c, int8_t low_c);
+
+// Sensor lido em todo ciclo mesmo sem alarme (ex.: o que fecha a malha de controle)
+void ds18b20_group_set_always_read(ds18b20_group_t * group, size_t index, bool always);
+
+// 🔍 ALARM SEARCH (0xEC) depois de uma conversão: marca em `alarmed` (um por
+// sensor do grupo) quem está fora dos limites. Retorna quantos.
+size_t ds18b20_group_alarm_search(ds18b20_group_t * group, bool * alarmed);
+
+// 💾 COPY SCRATCHPAD broadcast, só se algum sensor tem configuração ainda
+// não gravada (a EEPROM aguenta um número limitado de escritas)
+bool ds18b20_group_save_config(ds18b20_group_t * group);
+
+// ♻️ RECALL E² broadcast (ex.: depois de uma queda de alimentação). Sensores
+// cuja EEPROM já é conhecida não precisam ser relidos.
+bool ds18b20_group_recall(ds18b20_group_t * group);
+
+// 🔥 Uma conversão para todos (broadcast); false se ninguém respondeu ao reset
+bool ds18b20_group_convert(const ds18b20_group_t * group);
+
+// ⏱ Espera necessária para o sensor mais lento do grupo, em µs
+uint32_t ds18b20_group_conversion_time_us(const ds18b20_group_t * group);
+
+// 📥 Lê a temperatura de todos (MATCH ROM; rápida se habilitada). `errors`
+// pode ser NULL. Retorna DS18B20_OK só se todos foram lidos.
+DS18B20_ERROR ds18b20_group_read(ds18b20_group_t * group, float * temperatures, DS18B20_ERROR * errors);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DS18B20_GROUP_H
@@ -0,0 +1,104 @@
+#ifndef DS18B20_SCHED_H
+#define DS18B20_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "ds18b20.h"
+#include "ds18b20_group.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------
+// Agendador de conversões do DS18B20
+// Uma task própria envia o CONVERT T e dorme num esp_timer one-shot até o
+// fim da conversão (ou até o próximo read slot, no modo POLL); quem usa a
+// leitura só recebe o resultado pronto, pela fila e/ou pelo callback.
+// Com um grupo, cada ciclo é uma conversão broadcast seguida de uma leitura
+// por sensor (uma entrega por sensor, com `index`). Com o grupo em modo
+// alarme, o ciclo faz uma ALARM SEARCH e só entrega os sensores em alarme
+// e os marcados com ds18b20_group_set_always_read. Com um grupo criado por
+// ds18b20_group_init_cached, sensores que aparecem depois de um barramento
+// vazio entram no grupo no início do ciclo seguinte (ds18b20_group_rescan);
+// os que sumiram deixam de ser lidos, mas os always_read continuam sendo
+// entregues, com DS18B20_ERROR_DEVICE, até voltarem.
+// Enquanto estiver rodando, o agendador é o único dono do barramento 1-Wire.
+// ----------------------
+
+typedef enum
+{
+    DS18B20_WAIT_TIMER = 0,   // Espera o tempo máximo do datasheet para a resolução
+    DS18B20_WAIT_POLL,        // Read slots periódicos: termina assim que o sensor liberar (só com alimentação externa)
+} DS18B20_WAIT_MODE;
+
+typedef struct
+{
+    uint32_t seq;              // Incrementa a cada ciclo
+    uint8_t index;             // Sensor dentro do grupo (0 com um sensor só)
+    float temperature;         // °C (válido se error == DS18B20_OK)
+    DS18B20_ERROR error;
+    uint32_t conversion_us;    // Do CONVERT T até o fim da espera
+    int64_t timestamp_us;      // Fim do ciclo
+    bool alarm;                // Encontrado pela ALARM SEARCH (modo alarme)
+} ds18b20_reading_t;
+
+// Contexto da task do agendador: pode usar o barramento, mas não deve demorar
+typedef void (*ds18b20_reading_cb_t)(const ds18b20_reading_t * reading, void * ctx);
+
+typedef struct
+{
+    uint32_t period_ms;            // Intervalo entre o início de dois ciclos (0 = só com ds18b20_sched_trigger)
+    DS18B20_WAIT_MODE wait_mode;
+    uint32_t poll_interval_ms;     // Modo POLL: intervalo entre read slots (0 = 10 ms)
+    QueueHandle_t queue;           // Opcional: recebe ds18b20_reading_t (sem bloquear; cheia => descartada).
+                                   // Com grupo, dimensione para uma leitura por sensor.
+    ds18b20_reading_cb_t cb;       // Opcional
+    void * ctx;
+    UBaseType_t task_priority;
+} ds18b20_sched_config_t;
+
+typedef struct
+{
+    uint32_t cycles;               // Conversões iniciadas
+    uint32_t readings;             // Leituras entregues (uma por sensor por ciclo)
+    uint32_t errors;
+    uint32_t dropped;              // Leituras que não couberam na fila
+    uint32_t skipped;              // Modo alarme: sensores sem alarme que não precisaram ser lidos
+    uint32_t last_conversion_us;
+    uint32_t min_conversion_us;
+    uint32_t max_conversion_us;
+} ds18b20_sched_stats_t;
+
+// 🔧 Inicia o agendador para um sensor já inicializado
+esp_err_t ds18b20_sched_start(DS18B20_Info * sensor, const ds18b20_sched_config_t * config);
+
+// 🔧 Inicia o agendador para um grupo (conversão simultânea de todos)
+esp_err_t ds18b20_sched_start_group(ds18b20_group_t * group, const ds18b20_sched_config_t * config);
+
+// ⏹ Para o agendador (espera o ciclo em andamento terminar)
+void ds18b20_sched_stop(void);
+
+// ▶️ Pede um ciclo agora (ou logo depois do atual)
+void ds18b20_sched_trigger(void);
+
+// ⏱ Novo período (vale a partir do próximo ciclo)
+void ds18b20_sched_set_period(uint32_t period_ms);
+
+// ⚙️ Nova resolução para o(s) sensor(es), aplicada pela task do agendador
+// antes da próxima conversão
+void ds18b20_sched_set_resolution(DS18B20_RESOLUTION resolution);
+
+// ⏱ Tempo máximo de conversão do datasheet para a resolução, em µs
+uint32_t ds18b20_conversion_time_us(DS18B20_RESOLUTION resolution);
+
+void ds18b20_sched_get_stats(ds18b20_sched_stats_t * stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DS18B20_SCHED_H
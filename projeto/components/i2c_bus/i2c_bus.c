@@ -0,0 +1,393 @@
+#include "i2c_bus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#define TAG "I2C_BUS"
+
+#define I2C_BUS_QUEUE_LEN 16
+#define I2C_BUS_TASK_STACK 3072
+#define I2C_BUS_DEFAULT_RECOVER_AFTER 3
+#define I2C_BUS_GLITCH_IGNORE_CNT 7
+
+typedef enum {
+    I2C_BUS_OP_TRANSFER = 0,
+    I2C_BUS_OP_PROBE,
+    I2C_BUS_OP_RECOVER,
+} i2c_bus_op_t;
+
+// Pedido síncrono: vive na pilha de quem chamou até a worker liberar `done`.
+// Pedido assíncrono: sai do pool do dispositivo e volta para ele depois do
+// callback.
+typedef struct {
+    i2c_bus_device_handle_t dev;
+    i2c_bus_op_t op;
+    const uint8_t *write;
+    size_t write_len;
+    uint8_t *read;
+    size_t read_len;
+    int64_t enqueued_us;
+    esp_err_t result;
+    i2c_bus_done_cb_t cb;      // NULL => síncrono
+    void *ctx;
+} i2c_bus_request_t;
+
+typedef struct {
+    bool installed;
+    i2c_bus_config_t config;
+    i2c_master_bus_handle_t handle;
+    QueueHandle_t queues[I2C_BUS_PRIORITY_MAX];     // Ponteiros para i2c_bus_request_t
+    SemaphoreHandle_t pending;                      // Conta pedidos nas duas filas
+    TaskHandle_t worker;
+} i2c_bus_port_t;
+
+struct i2c_bus_device {
+    i2c_bus_port_t *bus;
+    i2c_bus_device_config_t config;
+    i2c_master_dev_handle_t handle;
+    SemaphoreHandle_t lock;    // Um pedido síncrono em voo por dispositivo
+    SemaphoreHandle_t done;    // Worker -> quem pediu
+    i2c_bus_request_t *pool;   // async_depth pedidos assíncronos
+    QueueHandle_t free_pool;   // Ponteiros livres de `pool`
+    uint8_t consecutive_errors;
+    i2c_bus_stats_t stats;
+};
+
+static i2c_bus_port_t s_ports[I2C_NUM_MAX];
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// ⚙️ Executa um pedido (contexto da worker)
+// O clock é do handle do dispositivo: o driver reprograma a porta sozinho
+// quando dispositivos com velocidades diferentes se alternam.
+static esp_err_t i2c_bus_execute(i2c_bus_request_t *req) {
+    i2c_bus_device_handle_t dev = req->dev;
+    int timeout_ms = (int)dev->config.timeout_ms;
+
+    switch (req->op) {
+    case I2C_BUS_OP_PROBE:
+        return i2c_master_probe(dev->bus->handle, dev->config.address, timeout_ms);
+
+    case I2C_BUS_OP_RECOVER: {
+        // Nove pulsos de SCL + STOP: solta um escravo que ficou segurando
+        // SDA no meio de um byte. Os outros dispositivos não perdem nada.
+        esp_err_t err = i2c_master_bus_reset(dev->bus->handle);
+        if (err != ESP_OK) {
+            return err;
+        }
+        return i2c_master_probe(dev->bus->handle, dev->config.address, timeout_ms);
+    }
+
+    case I2C_BUS_OP_TRANSFER:
+    default:
+        if (req->read_len > 0) {
+            return i2c_master_transmit_receive(dev->handle, req->write, req->write_len,
+                                               req->read, req->read_len, timeout_ms);
+        }
+        return i2c_master_transmit(dev->handle, req->write, req->write_len, timeout_ms);
+    }
+}
+
+// 📊 Contabiliza o resultado e decide se o dispositivo precisa de recuperação
+static bool i2c_bus_account(i2c_bus_request_t *req, int64_t started_us, int64_t finished_us) {
+    i2c_bus_device_handle_t dev = req->dev;
+    uint32_t queue_us = (uint32_t)(started_us - req->enqueued_us);
+    uint32_t latency_us = (uint32_t)(finished_us - req->enqueued_us);
+    uint32_t bus_us = (uint32_t)(finished_us - started_us);
+    bool needs_recovery = false;
+
+    portENTER_CRITICAL(&s_stats_lock);
+    i2c_bus_stats_t *st = &dev->stats;
+    st->transactions++;
+    st->last_latency_us = latency_us;
+    st->total_latency_us += latency_us;
+    st->total_bus_us += bus_us;
+    if (latency_us > st->max_latency_us) st->max_latency_us = latency_us;
+    if (queue_us > st->max_queue_us) st->max_queue_us = queue_us;
+
+    if (req->result == ESP_OK) {
+        st->bytes += req->write_len + req->read_len;
+        dev->consecutive_errors = 0;
+        if (req->op == I2C_BUS_OP_RECOVER) {
+            st->recoveries++;
+        }
+    } else if (req->op == I2C_BUS_OP_TRANSFER) {
+        st->errors++;
+        if (req->result == ESP_ERR_TIMEOUT) {
+            st->timeouts++;
+        }
+        uint8_t limit = dev->config.recover_after ? dev->config.recover_after : I2C_BUS_DEFAULT_RECOVER_AFTER;
+        if (++dev->consecutive_errors >= limit) {
+            dev->consecutive_errors = 0;
+            needs_recovery = true;
+        }
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+    return needs_recovery;
+}
+
+// 🧵 Worker da porta: sempre atende a fila alta antes da normal
+static void i2c_bus_worker(void *arg) {
+    i2c_bus_port_t *bus = (i2c_bus_port_t *)arg;
+
+    while (1) {
+        xSemaphoreTake(bus->pending, portMAX_DELAY);
+
+        i2c_bus_request_t *req = NULL;
+        for (int prio = I2C_BUS_PRIORITY_MAX - 1; prio >= 0 && req == NULL; prio--) {
+            xQueueReceive(bus->queues[prio], &req, 0);
+        }
+        if (req == NULL) {
+            continue;
+        }
+
+        int64_t started_us = esp_timer_get_time();
+        req->result = i2c_bus_execute(req);
+        bool recover = i2c_bus_account(req, started_us, esp_timer_get_time());
+
+        if (recover) {
+            // Recuperação automática, ainda antes de liberar quem pediu
+            i2c_bus_request_t fix = {.dev = req->dev, .op = I2C_BUS_OP_RECOVER, .enqueued_us = esp_timer_get_time()};
+            started_us = fix.enqueued_us;
+            fix.result = i2c_bus_execute(&fix);
+            i2c_bus_account(&fix, started_us, esp_timer_get_time());
+            ESP_LOGW(TAG, "🔄 %s: recuperação após falhas seguidas (%s)", req->dev->config.name,
+                     fix.result == ESP_OK ? "respondeu" : esp_err_to_name(fix.result));
+        }
+
+        if (req->cb != NULL) {
+            // Copia antes: depois de voltar ao pool o pedido pode ser reusado
+            i2c_bus_done_cb_t cb = req->cb;
+            void *ctx = req->ctx;
+            esp_err_t result = req->result;
+            xQueueSend(req->dev->free_pool, &req, 0);
+            cb(result, ctx);
+        } else {
+            xSemaphoreGive(req->dev->done);
+        }
+    }
+}
+
+esp_err_t i2c_bus_init(const i2c_bus_config_t *config) {
+    if (config->port < 0 || config->port >= I2C_NUM_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    i2c_bus_port_t *bus = &s_ports[config->port];
+
+    if (bus->installed) {
+        bool same_pins = bus->config.sda == config->sda && bus->config.scl == config->scl;
+        return same_pins ? ESP_OK : ESP_ERR_INVALID_STATE;
+    }
+
+    // trans_queue_depth = 0: o driver fica síncrono. A fila (com prioridade)
+    // é a nossa; no modo assíncrono do driver um dispositivo com callback
+    // registrado não aceita mais chamadas bloqueantes.
+    const i2c_master_bus_config_t bus_conf = {
+        .i2c_port = config->port,
+        .sda_io_num = config->sda,
+        .scl_io_num = config->scl,
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .glitch_ignore_cnt = I2C_BUS_GLITCH_IGNORE_CNT,
+        .flags.enable_internal_pullup = true,
+    };
+    esp_err_t err = i2c_new_master_bus(&bus_conf, &bus->handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    bus->config = *config;
+
+    for (int prio = 0; prio < I2C_BUS_PRIORITY_MAX; prio++) {
+        bus->queues[prio] = xQueueCreate(I2C_BUS_QUEUE_LEN, sizeof(i2c_bus_request_t *));
+    }
+    bus->pending = xSemaphoreCreateCounting(I2C_BUS_QUEUE_LEN * I2C_BUS_PRIORITY_MAX, 0);
+    if (bus->queues[0] == NULL || bus->queues[1] == NULL || bus->pending == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    char name[16];
+    snprintf(name, sizeof(name), "i2c_bus_%d", config->port);
+    if (xTaskCreate(i2c_bus_worker, name, I2C_BUS_TASK_STACK, bus, config->task_priority, &bus->worker) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    bus->installed = true;
+    ESP_LOGI(TAG, "✅ I2C%d pronto (SDA %d, SCL %d)", config->port, config->sda, config->scl);
+    return ESP_OK;
+}
+
+esp_err_t i2c_bus_add_device(i2c_port_t port, const i2c_bus_device_config_t *config,
+                             i2c_bus_device_handle_t *handle) {
+    if (port < 0 || port >= I2C_NUM_MAX || !s_ports[port].installed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    i2c_bus_device_handle_t dev = calloc(1, sizeof(struct i2c_bus_device));
+    if (dev == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    dev->bus = &s_ports[port];
+    dev->config = *config;
+    if (dev->config.priority >= I2C_BUS_PRIORITY_MAX) {
+        dev->config.priority = I2C_BUS_PRIORITY_HIGH;
+    }
+
+    const i2c_device_config_t dev_conf = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = config->address,
+        .scl_speed_hz = config->clk_hz,
+    };
+    esp_err_t err = i2c_master_bus_add_device(dev->bus->handle, &dev_conf, &dev->handle);
+    if (err != ESP_OK) {
+        free(dev);
+        return err;
+    }
+
+    dev->lock = xSemaphoreCreateMutex();
+    dev->done = xSemaphoreCreateBinary();
+    if (dev->lock == NULL || dev->done == NULL) {
+        i2c_master_bus_rm_device(dev->handle);
+        free(dev);
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (config->async_depth > 0) {
+        dev->pool = calloc(config->async_depth, sizeof(i2c_bus_request_t));
+        dev->free_pool = xQueueCreate(config->async_depth, sizeof(i2c_bus_request_t *));
+        if (dev->pool == NULL || dev->free_pool == NULL) {
+            i2c_master_bus_rm_device(dev->handle);
+            free(dev->pool);
+            free(dev);
+            return ESP_ERR_NO_MEM;
+        }
+        for (int i = 0; i < config->async_depth; i++) {
+            i2c_bus_request_t *req = &dev->pool[i];
+            xQueueSend(dev->free_pool, &req, 0);
+        }
+    }
+
+    *handle = dev;
+    return ESP_OK;
+}
+
+// 📨 Coloca o pedido na fila da prioridade do dispositivo
+static esp_err_t i2c_bus_enqueue(i2c_bus_request_t *req) {
+    i2c_bus_device_handle_t dev = req->dev;
+    i2c_bus_port_t *bus = dev->bus;
+
+    req->enqueued_us = esp_timer_get_time();
+    if (xQueueSend(bus->queues[dev->config.priority], &req, pdMS_TO_TICKS(dev->config.timeout_ms)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;  // Barramento congestionado
+    }
+    xSemaphoreGive(bus->pending);
+    return ESP_OK;
+}
+
+// 📨 Entrega o pedido à worker e espera o resultado
+static esp_err_t i2c_bus_submit(i2c_bus_request_t *req) {
+    i2c_bus_device_handle_t dev = req->dev;
+
+    xSemaphoreTake(dev->lock, portMAX_DELAY);
+    esp_err_t err = i2c_bus_enqueue(req);
+    if (err != ESP_OK) {
+        xSemaphoreGive(dev->lock);
+        return err;
+    }
+
+    // O pedido está na nossa pilha: só saímos depois que a worker terminou
+    xSemaphoreTake(dev->done, portMAX_DELAY);
+    xSemaphoreGive(dev->lock);
+    return req->result;
+}
+
+esp_err_t i2c_bus_write(i2c_bus_device_handle_t dev, const uint8_t *data, size_t len) {
+    i2c_bus_request_t req = {.dev = dev, .op = I2C_BUS_OP_TRANSFER, .write = data, .write_len = len};
+    return i2c_bus_submit(&req);
+}
+
+esp_err_t i2c_bus_write_read(i2c_bus_device_handle_t dev, const uint8_t *write, size_t write_len,
+                             uint8_t *read, size_t read_len) {
+    i2c_bus_request_t req = {
+        .dev = dev,
+        .op = I2C_BUS_OP_TRANSFER,
+        .write = write,
+        .write_len = write_len,
+        .read = read,
+        .read_len = read_len,
+    };
+    return i2c_bus_submit(&req);
+}
+
+// 📨 Pega um pedido do pool e o entrega sem esperar a transação
+static esp_err_t i2c_bus_submit_async(const i2c_bus_request_t *tmpl) {
+    i2c_bus_device_handle_t dev = tmpl->dev;
+    if (dev->free_pool == NULL || tmpl->cb == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    i2c_bus_request_t *req;
+    if (xQueueReceive(dev->free_pool, &req, 0) != pdTRUE) {
+        // Pool esgotado: espera um pedido anterior terminar
+        portENTER_CRITICAL(&s_stats_lock);
+        dev->stats.async_full++;
+        portEXIT_CRITICAL(&s_stats_lock);
+        if (xQueueReceive(dev->free_pool, &req, pdMS_TO_TICKS(dev->config.timeout_ms)) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+    }
+
+    *req = *tmpl;
+    esp_err_t err = i2c_bus_enqueue(req);
+    if (err != ESP_OK) {
+        xQueueSend(dev->free_pool, &req, 0);
+    }
+    return err;
+}
+
+esp_err_t i2c_bus_write_async(i2c_bus_device_handle_t dev, const uint8_t *data, size_t len,
+                              i2c_bus_done_cb_t cb, void *ctx) {
+    const i2c_bus_request_t req = {
+        .dev = dev,
+        .op = I2C_BUS_OP_TRANSFER,
+        .write = data,
+        .write_len = len,
+        .cb = cb,
+        .ctx = ctx,
+    };
+    return i2c_bus_submit_async(&req);
+}
+
+esp_err_t i2c_bus_write_read_async(i2c_bus_device_handle_t dev, const uint8_t *write, size_t write_len,
+                                   uint8_t *read, size_t read_len, i2c_bus_done_cb_t cb, void *ctx) {
+    const i2c_bus_request_t req = {
+        .dev = dev,
+        .op = I2C_BUS_OP_TRANSFER,
+        .write = write,
+        .write_len = write_len,
+        .read = read,
+        .read_len = read_len,
+        .cb = cb,
+        .ctx = ctx,
+    };
+    return i2c_bus_submit_async(&req);
+}
+
+esp_err_t i2c_bus_probe(i2c_bus_device_handle_t dev) {
+    i2c_bus_request_t req = {.dev = dev, .op = I2C_BUS_OP_PROBE};
+    return i2c_bus_submit(&req);
+}
+
+esp_err_t i2c_bus_device_recover(i2c_bus_device_handle_t dev) {
+    i2c_bus_request_t req = {.dev = dev, .op = I2C_BUS_OP_RECOVER};
+    return i2c_bus_submit(&req);
+}
+
+void i2c_bus_get_stats(i2c_bus_device_handle_t dev, i2c_bus_stats_t *stats) {
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = dev->stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
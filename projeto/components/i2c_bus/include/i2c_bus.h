@@ -0,0 +1,106 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/i2c_master.h"
+
+// ----------------------
+// Gerenciador de barramento I2C
+// Cada porta tem um único dono: uma task worker que executa as transações
+// de todos os dispositivos registrados nela, uma de cada vez. Os pedidos
+// entram em duas filas; a de prioridade alta é sempre esvaziada primeiro,
+// então uma leitura de sensor passa na frente dos flushes do display que
+// ainda estão esperando. Falhas são tratadas por dispositivo: o barramento
+// nunca é desinstalado por causa de um periférico.
+//
+// Por baixo fica o driver i2c_master: cada dispositivo tem seu próprio
+// handle (endereço e clock fixos), sem command link alocado por transação.
+// Além das chamadas síncronas há as assíncronas (_async): o pedido sai de
+// um pool do dispositivo, quem chamou segue em frente e o callback roda na
+// worker quando a transação termina.
+// ----------------------
+
+typedef enum {
+    I2C_BUS_PRIORITY_NORMAL = 0,
+    I2C_BUS_PRIORITY_HIGH,
+    I2C_BUS_PRIORITY_MAX,
+} i2c_bus_priority_t;
+
+// ⚙️ Porta
+typedef struct {
+    i2c_port_t port;
+    gpio_num_t sda;
+    gpio_num_t scl;
+    UBaseType_t task_priority;   // Prioridade da worker da porta
+} i2c_bus_config_t;
+
+// ⚙️ Dispositivo
+typedef struct {
+    const char *name;            // Só para logs
+    uint8_t address;             // Endereço de 7 bits
+    uint32_t clk_hz;             // Velocidade usada nas transações deste dispositivo
+    uint32_t timeout_ms;         // Tempo máximo de uma transação
+    i2c_bus_priority_t priority;
+    uint8_t recover_after;       // Falhas seguidas até a recuperação automática (0 = 3)
+    uint8_t async_depth;         // Pedidos assíncronos em voo ao mesmo tempo (0 = só síncrono)
+} i2c_bus_device_config_t;
+
+// 📊 Estatísticas por dispositivo
+typedef struct {
+    uint32_t transactions;
+    uint32_t errors;
+    uint32_t timeouts;
+    uint32_t recoveries;
+    uint64_t bytes;              // Bytes de dados (escritos + lidos)
+    uint32_t last_latency_us;    // Da entrada na fila até o fim da transação
+    uint32_t max_latency_us;
+    uint64_t total_latency_us;   // Soma, para média = total / transactions
+    uint32_t max_queue_us;       // Maior espera na fila antes de ir ao barramento
+    uint64_t total_bus_us;       // Só o tempo dentro do driver (sem a fila)
+    uint32_t async_full;         // Vezes em que o pool assíncrono estava esgotado
+} i2c_bus_stats_t;
+
+typedef struct i2c_bus_device *i2c_bus_device_handle_t;
+
+// ✅ Fim de uma transação assíncrona (contexto da worker: não bloquear)
+typedef void (*i2c_bus_done_cb_t)(esp_err_t result, void *ctx);
+
+// 🔧 Cria o barramento i2c_master e a worker da porta. Chamar de novo com os mesmos
+// pinos é inofensivo (retorna ESP_OK); pinos diferentes => ESP_ERR_INVALID_STATE.
+esp_err_t i2c_bus_init(const i2c_bus_config_t *config);
+
+// ➕ Registra um dispositivo numa porta já inicializada
+esp_err_t i2c_bus_add_device(i2c_port_t port, const i2c_bus_device_config_t *config,
+                             i2c_bus_device_handle_t *handle);
+
+// 📤 Escrita
+esp_err_t i2c_bus_write(i2c_bus_device_handle_t dev, const uint8_t *data, size_t len);
+
+// 📥 Escrita seguida de leitura com repeated start (ex.: registrador + dados)
+esp_err_t i2c_bus_write_read(i2c_bus_device_handle_t dev, const uint8_t *write, size_t write_len,
+                             uint8_t *read, size_t read_len);
+
+// 📤 Escrita assíncrona: `data` precisa continuar válido até o callback.
+// Pedidos do mesmo dispositivo são executados na ordem em que entraram.
+esp_err_t i2c_bus_write_async(i2c_bus_device_handle_t dev, const uint8_t *data, size_t len,
+                              i2c_bus_done_cb_t cb, void *ctx);
+
+// 📥 Escrita + leitura assíncrona: os dois buffers valem até o callback
+esp_err_t i2c_bus_write_read_async(i2c_bus_device_handle_t dev, const uint8_t *write, size_t write_len,
+                                   uint8_t *read, size_t read_len, i2c_bus_done_cb_t cb, void *ctx);
+
+// 🔍 Verifica se o dispositivo responde ao endereço (ACK)
+esp_err_t i2c_bus_probe(i2c_bus_device_handle_t dev);
+
+// 🔄 Recupera o dispositivo sem desmontar o barramento: gera os pulsos de
+// clock que soltam um escravo travado em SDA e confere se ele responde
+esp_err_t i2c_bus_device_recover(i2c_bus_device_handle_t dev);
+
+// 📊 Estatísticas do dispositivo
+void i2c_bus_get_stats(i2c_bus_device_handle_t dev, i2c_bus_stats_t *stats);
+
+#endif // I2C_BUS_H
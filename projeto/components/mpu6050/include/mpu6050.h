@@ -1,8 +1,14 @@
 #ifndef MPU6050_H
 #define MPU6050_H
 
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 #include "esp_err.h"
-#include "driver/i2c.h"
+#include "i2c_bus.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 // Endereço do MPU6050 (0x68 ou 0x69 se AD0 estiver em HIGH)
 #define MPU6050_ADDRESS 0x68  
@@ -12,12 +18,44 @@
 #define MPU6050_REG_ACCEL_XOUT_H 0x3B
 #define MPU6050_REG_GYRO_XOUT_H  0x43
 #define MPU6050_REG_WHO_AM_I     0x75
+#define MPU6050_REG_SMPLRT_DIV   0x19
+#define MPU6050_REG_CONFIG       0x1A
+#define MPU6050_REG_FIFO_EN      0x23
+#define MPU6050_REG_INT_STATUS   0x3A
+#define MPU6050_REG_USER_CTRL    0x6A
+#define MPU6050_REG_FIFO_COUNT_H 0x72
+#define MPU6050_REG_FIFO_R_W     0x74
+#define MPU6050_REG_GYRO_CONFIG  0x1B
+#define MPU6050_REG_ACCEL_CONFIG 0x1C
+#define MPU6050_REG_MOT_THR      0x1F
+#define MPU6050_REG_MOT_DUR      0x20
+#define MPU6050_REG_INT_PIN_CFG  0x37
+#define MPU6050_REG_INT_ENABLE   0x38
 
-// Configuração do barramento I2C
-#define I2C_MASTER_NUM I2C_NUM_0
+// Bits de FIFO_EN / USER_CTRL
+#define MPU6050_FIFO_EN_ACCEL_GYRO 0x78  // XG, YG, ZG e ACCEL (sem temperatura)
+#define MPU6050_USER_CTRL_FIFO_EN    0x40
+#define MPU6050_USER_CTRL_FIFO_RESET 0x04
+
+// Bits de INT_ENABLE / INT_STATUS
+#define MPU6050_INT_DATA_RDY   0x01
+#define MPU6050_INT_FIFO_OFLOW 0x10
+#define MPU6050_INT_MOTION     0x40
+
+// Configuração do barramento I2C (porta própria; a 0 é do display)
+#define I2C_MASTER_NUM I2C_NUM_1
 #define I2C_MASTER_SDA_IO 17  
 #define I2C_MASTER_SCL_IO 18 
-#define I2C_MASTER_FREQ_HZ 10000  // Redução da velocidade do I2C
+#define I2C_MASTER_FREQ_HZ 400000  // Fast mode: necessário para esvaziar a FIFO a 1 kHz
+#define MPU6050_I2C_TIMEOUT_MS 50
+
+// Pino INT do MPU6050 (ativo em nível alto)
+#define MPU6050_INT_GPIO GPIO_NUM_16
+
+// FIFO do MPU6050
+#define MPU6050_FIFO_SIZE 1024
+#define MPU6050_FIFO_SAMPLE_BYTES 12   // accel XYZ + gyro XYZ, big-endian
+#define MPU6050_SAMPLE_RING_SIZE 256   // Amostras guardadas entre leituras da aplicação
 
 // Estrutura para armazenar os dados do MPU6050
 typedef struct {
@@ -31,13 +69,220 @@ typedef struct {
     float pitch;
 } mpu6050_data_t;
 
+// 📦 Amostra bruta vinda da FIFO, com instante estimado de aquisição
+typedef struct {
+    int64_t timestamp_us;  // esp_timer_get_time()
+    int16_t accel[3];      // X, Y, Z
+    int16_t gyro[3];       // X, Y, Z
+} mpu6050_sample_t;
+
+// ⚙️ Configuração do modo FIFO
+typedef struct {
+    uint16_t sample_rate_hz;  // 4..1000 (taxa interna de 1 kHz com o DLPF ligado)
+    uint8_t dlpf_cfg;         // 1..6: banda do filtro passa-baixa (1 = 184 Hz ... 6 = 5 Hz)
+} mpu6050_fifo_config_t;
+
+// 📊 Contadores do modo FIFO
+typedef struct {
+    uint32_t samples;       // Amostras lidas da FIFO
+    uint32_t transactions;  // Transações I2C feitas pelo dreno
+    uint32_t overflows;     // Estouros da FIFO (dados descartados e FIFO reiniciada)
+    uint32_t ring_dropped;  // Amostras antigas sobrescritas no ring buffer
+} mpu6050_fifo_stats_t;
+
+// ⚙️ Configuração da interrupção (pino INT)
+typedef struct {
+    gpio_num_t gpio;             // Pino ligado ao INT do MPU6050
+    uint8_t enable_mask;         // MPU6050_INT_MOTION | MPU6050_INT_DATA_RDY | ...
+    uint8_t motion_threshold;    // MOT_THR: 1 LSB = 2 mg
+    uint8_t motion_duration_ms;  // MOT_DUR: amostras de 1 ms acima do limiar
+    TaskHandle_t notify_task;    // Task acordada pela ISR
+} mpu6050_int_config_t;
+
+// 📏 Faixas de medida (AFS_SEL / FS_SEL, bits 4:3 de ACCEL_CONFIG / GYRO_CONFIG)
+typedef enum {
+    MPU6050_ACCEL_FS_2G = 0,   // 16384 LSB/g
+    MPU6050_ACCEL_FS_4G,       // 8192 LSB/g
+    MPU6050_ACCEL_FS_8G,       // 4096 LSB/g
+    MPU6050_ACCEL_FS_16G,      // 2048 LSB/g
+} mpu6050_accel_fs_t;
+
+typedef enum {
+    MPU6050_GYRO_FS_250DPS = 0,   // 131 LSB/(°/s)
+    MPU6050_GYRO_FS_500DPS,       // 65,5 LSB/(°/s)
+    MPU6050_GYRO_FS_1000DPS,      // 32,8 LSB/(°/s)
+    MPU6050_GYRO_FS_2000DPS,      // 16,4 LSB/(°/s)
+} mpu6050_gyro_fs_t;
+
+// 💾 Calibração persistida em NVS
+typedef struct {
+    uint16_t version;          // MPU6050_CALIB_VERSION
+    uint8_t accel_fs;          // Faixas em que foi feita (mpu6050_*_fs_t)
+    uint8_t gyro_fs;
+    int16_t accel_offset[3];   // LSB subtraídos antes da escala
+    int16_t gyro_offset[3];
+    float accel_gain;          // Correção de escala comum: |g| medido -> 9,80665 m/s²
+} mpu6050_calib_t;
+
+#define MPU6050_CALIB_VERSION 1
+
+// ⚙️ Conversão pré-calculada LSB -> SI: out = ((raw - offset) * gain) >> 16
+typedef struct {
+    int32_t offset[6];    // accel XYZ, gyro XYZ
+    int32_t gain_q16[6];  // mm/s² ou m°/s por LSB, em Q16
+} mpu6050_scaler_t;
+
+// 📦 Amostra em unidades SI, em inteiros (milésimos) para não usar float no
+// caminho de 1 kHz. Use MPU6050_MILLI_TO_SI() para m/s² e °/s.
+typedef struct {
+    int64_t timestamp_us;
+    int32_t accel_mms2[3];  // mm/s²
+    int32_t gyro_mdps[3];   // m°/s (milésimos de grau por segundo)
+} mpu6050_si_sample_t;
+
+#define MPU6050_MILLI_TO_SI(x) ((float)(x) * 0.001f)
+#define MPU6050_GRAVITY 9.80665f
+
+// 🧭 Filtro de orientação Mahony (quatérnio, float simples)
+typedef struct {
+    float q[4];              // Quatérnio w, x, y, z (sensor -> mundo)
+    float integral[3];       // Termo integral do erro (rad/s)
+    float kp, ki;            // Ganhos proporcional e integral
+    float dt;                // Período de amostragem (s)
+    float gyro_scale;        // rad/s por LSB do giroscópio
+    float gyro_bias[3];      // Bias do giroscópio em LSB (calibrado em repouso)
+    bool initialized;        // false => a primeira amostra alinha q com a gravidade
+} mpu6050_mahony_t;
+
+// 📊 Contadores da interrupção
+typedef struct {
+    uint32_t interrupts;       // Bordas vistas pela ISR (inclui as simuladas)
+    uint32_t motion_events;
+    uint32_t data_ready_events;
+    uint32_t fifo_overflows;
+    uint32_t last_latency_us;  // ISR -> task leu INT_STATUS
+    uint32_t max_latency_us;
+} mpu6050_int_stats_t;
+
 // Declaração das funções
 esp_err_t i2c_master_init();
 esp_err_t mpu6050_write_register(uint8_t reg_addr, uint8_t data);
 esp_err_t mpu6050_read_registers(uint8_t reg_addr, uint8_t *data, size_t len);
+esp_err_t mpu6050_bus_recover();
+void mpu6050_get_bus_stats(i2c_bus_stats_t *stats);
 esp_err_t test_mpu6050();
 esp_err_t mpu6050_init();
 esp_err_t mpu6050_read_data(mpu6050_data_t *sensor_data);
 void calculate_euler_angles(mpu6050_data_t *sensor_data);
 
+// ----------------------
+// Modo FIFO: o MPU6050 amostra sozinho na taxa configurada e a aplicação
+// esvazia a FIFO em rajadas. Cada rajada custa duas transações I2C
+// (FIFO_COUNT + leitura em bloco), independente de quantas amostras traz.
+// ----------------------
+
+// 🚀 Configura SMPLRT_DIV/CONFIG, zera e liga a FIFO com accel + gyro
+esp_err_t mpu6050_fifo_start(const mpu6050_fifo_config_t *config);
+
+// ⏹ Desliga a FIFO
+esp_err_t mpu6050_fifo_stop();
+
+// 🔄 Lê tudo o que está na FIFO para o ring buffer. Retorna o número de
+// amostras novas (0 se vazia, < 0 em erro de I2C). Em estouro a FIFO é
+// zerada, as amostras desalinhadas descartadas e o contador incrementado.
+int mpu6050_fifo_drain();
+
+// 📥 Retira até max amostras do ring buffer (mais antigas primeiro)
+size_t mpu6050_fifo_pop(mpu6050_sample_t *samples, size_t max);
+
+// 📊 Contadores do modo FIFO
+void mpu6050_fifo_get_stats(mpu6050_fifo_stats_t *stats);
+
+// 🗑 Descarta o conteúdo da FIFO (ex.: amostras acumuladas durante o repouso)
+esp_err_t mpu6050_fifo_flush();
+
+// ----------------------
+// Interrupção: o MPU6050 puxa o pino INT em data-ready, detecção de
+// movimento ou estouro da FIFO; a ISR só notifica a task configurada,
+// que dorme em mpu6050_int_wait() sem consumir CPU.
+// ----------------------
+
+// 🔔 Configura MOT_THR/MOT_DUR/INT_PIN_CFG/INT_ENABLE e a ISR do GPIO
+esp_err_t mpu6050_int_start(const mpu6050_int_config_t *config);
+
+// ⏹ Desliga as interrupções no MPU6050 e remove a ISR
+esp_err_t mpu6050_int_stop();
+
+// 💤 Dorme até a próxima interrupção (ou timeout). Em ESP_OK, *status traz
+// os bits de INT_STATUS (a leitura também libera o pino INT).
+esp_err_t mpu6050_int_wait(TickType_t timeout, uint8_t *status);
+
+// 🧪 Simula uma borda no INT com os bits de status dados: permite testar o
+// caminho da task sem o fio INT ligado (ou sem o sensor)
+void mpu6050_int_simulate(uint8_t status);
+
+// 📊 Contadores da interrupção
+void mpu6050_int_get_stats(mpu6050_int_stats_t *stats);
+
+// ----------------------
+// Orientação: filtro complementar de Mahony sobre o quatérnio, atualizado
+// a cada amostra da FIFO. O giroscópio integra o movimento rápido e a
+// gravidade medida pelo acelerômetro corrige a deriva de roll/pitch.
+// Tudo em float (a FPU do ESP32-S3 é de precisão simples).
+// ----------------------
+
+// 🔧 Prepara o filtro para a taxa de amostragem e a faixa do giroscópio
+// configurada (mpu6050_set_full_scale); a faixa define a escala LSB -> rad/s
+void mpu6050_mahony_init(mpu6050_mahony_t *filter, float sample_rate_hz, float kp, float ki,
+                         mpu6050_gyro_fs_t gyro_fs);
+
+// 🔄 Integra uma amostra
+void mpu6050_mahony_update(mpu6050_mahony_t *filter, const mpu6050_sample_t *sample);
+
+// 📐 Ângulos de Euler em graus (qualquer ponteiro pode ser NULL)
+void mpu6050_mahony_get_euler(const mpu6050_mahony_t *filter, float *roll, float *pitch, float *yaw);
+
+// ⚖️ Usa o bias de uma calibração persistida (mpu6050_calib_t) no filtro
+void mpu6050_mahony_set_bias(mpu6050_mahony_t *filter, const int16_t gyro_offset[3]);
+
+// ⚡ Aproximações rápidas usadas pelo filtro
+float mpu6050_fast_inv_sqrt(float x);
+float mpu6050_fast_atan2(float y, float x);
+
+// ----------------------
+// Faixas de medida, calibração e conversão para SI
+// A calibração é feita com o sensor parado e nivelado (Z para cima):
+// offsets do giroscópio e de X/Y do acelerômetro pela média, e um ganho
+// comum do acelerômetro que leva o módulo da gravidade a 1 g. Fica em NVS
+// e, na decodificação, vira só subtração + multiplicação em ponto fixo.
+// ----------------------
+
+// 📏 Grava GYRO_CONFIG / ACCEL_CONFIG (preserva o passa-altas do detector de movimento)
+esp_err_t mpu6050_set_full_scale(mpu6050_accel_fs_t accel_fs, mpu6050_gyro_fs_t gyro_fs);
+
+// Sensibilidade do giroscópio na faixa dada, em LSB/(°/s)
+float mpu6050_gyro_lsb_per_dps(mpu6050_gyro_fs_t gyro_fs);
+
+// ⚖️ Calcula a calibração a partir de amostras em repouso. Retorna false se
+// houve movimento ou se há poucas amostras.
+bool mpu6050_calib_compute(const mpu6050_sample_t *samples, size_t count,
+                           mpu6050_accel_fs_t accel_fs, mpu6050_gyro_fs_t gyro_fs,
+                           mpu6050_calib_t *calib);
+
+// 💾 Lê/grava a calibração em NVS (nvs_flash_init() já deve ter sido chamado).
+// load retorna ESP_ERR_NOT_FOUND se não há calibração válida salva.
+esp_err_t mpu6050_calib_load(mpu6050_calib_t *calib);
+esp_err_t mpu6050_calib_save(const mpu6050_calib_t *calib);
+
+// 🔧 Pré-calcula offsets e ganhos Q16 (calib pode ser NULL: só escala nominal)
+void mpu6050_scaler_init(mpu6050_scaler_t *scaler, const mpu6050_calib_t *calib,
+                         mpu6050_accel_fs_t accel_fs, mpu6050_gyro_fs_t gyro_fs);
+
+// 🔄 Converte amostras brutas em SI (sem alocação, sem desvios no laço)
+void mpu6050_scaler_apply(const mpu6050_scaler_t *scaler, const mpu6050_sample_t *in,
+                          mpu6050_si_sample_t *out, size_t count);
+
+// 📏 Fator float m/s² por LSB do acelerômetro (com o ganho da calibração)
+float mpu6050_scaler_accel_mps2_per_lsb(const mpu6050_scaler_t *scaler);
+
 #endif // MPU6050_H
\ No newline at end of file
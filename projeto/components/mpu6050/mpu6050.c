@@ -1,40 +1,77 @@
 #include "mpu6050.h"
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
 
-// 🔹 Inicializar o I2C corretamente
+static i2c_bus_device_handle_t s_dev = NULL;
+
+// 🔹 Registrar o MPU6050 no gerenciador do barramento I2C
+// Prioridade alta: as leituras da FIFO passam na frente de escritas em
+// massa de outros dispositivos na mesma porta.
 esp_err_t i2c_master_init()
 {
-    i2c_config_t i2c_conf = {
-        .mode = I2C_MODE_MASTER,
-        .sda_io_num = I2C_MASTER_SDA_IO,
-        .scl_io_num = I2C_MASTER_SCL_IO,
-        .sda_pullup_en = GPIO_PULLUP_ENABLE,  // 🔹 Ativa pull-up interno
-        .scl_pullup_en = GPIO_PULLUP_ENABLE,  // 🔹 Ativa pull-up interno
-        .master.clk_speed = I2C_MASTER_FREQ_HZ
-    };
+    if (s_dev != NULL) {
+        return ESP_OK;
+    }
 
-    esp_err_t err = i2c_param_config(I2C_MASTER_NUM, &i2c_conf);
+    const i2c_bus_config_t bus_conf = {
+        .port = I2C_MASTER_NUM,
+        .sda = I2C_MASTER_SDA_IO,
+        .scl = I2C_MASTER_SCL_IO,
+        .task_priority = 7,
+    };
+    esp_err_t err = i2c_bus_init(&bus_conf);
     if (err != ESP_OK)
     {
         return err;
     }
 
-    return i2c_driver_install(I2C_MASTER_NUM, i2c_conf.mode, 0, 0, 0);
+    const i2c_bus_device_config_t dev_conf = {
+        .name = "mpu6050",
+        .address = MPU6050_ADDRESS,
+        .clk_hz = I2C_MASTER_FREQ_HZ,
+        .timeout_ms = MPU6050_I2C_TIMEOUT_MS,
+        .priority = I2C_BUS_PRIORITY_HIGH,
+    };
+    return i2c_bus_add_device(I2C_MASTER_NUM, &dev_conf, &s_dev);
 }
 
 // 🔹 Escrever em um registrador do MPU6050
 esp_err_t mpu6050_write_register(uint8_t reg_addr, uint8_t data)
 {
+    if (s_dev == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
     uint8_t write_buf[2] = {reg_addr, data};
-    return i2c_master_write_to_device(I2C_MASTER_NUM, MPU6050_ADDRESS, write_buf, sizeof(write_buf), pdMS_TO_TICKS(1000));
+    return i2c_bus_write(s_dev, write_buf, sizeof(write_buf));
 }
 
 // 🔹 Ler múltiplos registradores do MPU6050
 esp_err_t mpu6050_read_registers(uint8_t reg_addr, uint8_t *data, size_t len)
 {
-    esp_err_t err = i2c_master_write_read_device(I2C_MASTER_NUM, MPU6050_ADDRESS, &reg_addr, 1, data, len, pdMS_TO_TICKS(1000));
-    return err;
+    if (s_dev == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return i2c_bus_write_read(s_dev, &reg_addr, 1, data, len);
+}
+
+// 🔹 Recuperar o MPU6050 sem desinstalar o barramento
+esp_err_t mpu6050_bus_recover()
+{
+    if (s_dev == NULL) {
+        return i2c_master_init();
+    }
+    return i2c_bus_device_recover(s_dev);
+}
+
+// 🔹 Estatísticas de I2C do MPU6050
+void mpu6050_get_bus_stats(i2c_bus_stats_t *stats)
+{
+    if (s_dev == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    i2c_bus_get_stats(s_dev, stats);
 }
 
 // 🔹 Teste de comunicação WHO_AM_I
@@ -83,9 +120,13 @@ esp_err_t mpu6050_read_data(mpu6050_data_t *sensor_data)
     return ret;
 }
 
-// 🔹 Calcular ângulos de Euler
+// 🔹 Calcular ângulos de Euler (só acelerômetro; para orientação sob
+// vibração use o filtro mpu6050_mahony_*)
 void calculate_euler_angles(mpu6050_data_t *sensor_data)
 {
-    sensor_data->roll  = atan2(sensor_data->accel_y, sensor_data->accel_z) * 180 / M_PI;
-    sensor_data->pitch = atan2(-sensor_data->accel_x, sqrt(sensor_data->accel_y * sensor_data->accel_y + sensor_data->accel_z * sensor_data->accel_z)) * 180 / M_PI;
+    float ax = sensor_data->accel_x;
+    float ay = sensor_data->accel_y;
+    float az = sensor_data->accel_z;
+    sensor_data->roll  = mpu6050_fast_atan2(ay, az) * 57.29578f;
+    sensor_data->pitch = mpu6050_fast_atan2(-ax, sqrtf(ay * ay + az * az)) * 57.29578f;
 }
\ No newline at end of file
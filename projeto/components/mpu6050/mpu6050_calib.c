@@ -0,0 +1,185 @@
+#include "mpu6050.h"
+#include <string.h>
+#include <math.h>
+#include "nvs.h"
+#include "esp_log.h"
+
+#define TAG "MPU6050_CAL"
+
+#define MPU6050_NVS_NAMESPACE "mpu6050"
+#define MPU6050_NVS_KEY "calib"
+
+#define MPU6050_FS_SHIFT 3
+#define MPU6050_FS_MASK 0x18
+
+// Calibração: mínimo de amostras, maior variação do giroscópio (°/s) e
+// maior inclinação (fração de g em X/Y) para aceitar "parado e nivelado"
+#define CALIB_MIN_SAMPLES 64
+#define CALIB_MAX_GYRO_SPAN_DPS 2.0f
+#define CALIB_MAX_TILT_G 0.1f
+
+// LSB por unidade em cada faixa
+static const float s_accel_lsb_per_g[] = {16384.0f, 8192.0f, 4096.0f, 2048.0f};
+static const float s_gyro_lsb_per_dps[] = {131.0f, 65.5f, 32.8f, 16.4f};
+
+float mpu6050_gyro_lsb_per_dps(mpu6050_gyro_fs_t gyro_fs)
+{
+    return s_gyro_lsb_per_dps[gyro_fs];
+}
+
+esp_err_t mpu6050_set_full_scale(mpu6050_accel_fs_t accel_fs, mpu6050_gyro_fs_t gyro_fs)
+{
+    esp_err_t err = mpu6050_write_register(MPU6050_REG_GYRO_CONFIG, (uint8_t)(gyro_fs << MPU6050_FS_SHIFT));
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    uint8_t accel_config;
+    err = mpu6050_read_registers(MPU6050_REG_ACCEL_CONFIG, &accel_config, 1);
+    if (err != ESP_OK) {
+        return err;
+    }
+    accel_config = (accel_config & ~MPU6050_FS_MASK) | (uint8_t)(accel_fs << MPU6050_FS_SHIFT);
+    return mpu6050_write_register(MPU6050_REG_ACCEL_CONFIG, accel_config);
+}
+
+bool mpu6050_calib_compute(const mpu6050_sample_t *samples, size_t count,
+                           mpu6050_accel_fs_t accel_fs, mpu6050_gyro_fs_t gyro_fs,
+                           mpu6050_calib_t *calib)
+{
+    if (count < CALIB_MIN_SAMPLES) {
+        return false;
+    }
+
+    int32_t accel_sum[3] = {0, 0, 0};
+    int32_t gyro_sum[3] = {0, 0, 0};
+    int16_t gyro_min[3] = {INT16_MAX, INT16_MAX, INT16_MAX};
+    int16_t gyro_max[3] = {INT16_MIN, INT16_MIN, INT16_MIN};
+    for (size_t i = 0; i < count; i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            int16_t g = samples[i].gyro[axis];
+            accel_sum[axis] += samples[i].accel[axis];
+            gyro_sum[axis] += g;
+            if (g < gyro_min[axis]) gyro_min[axis] = g;
+            if (g > gyro_max[axis]) gyro_max[axis] = g;
+        }
+    }
+
+    const float max_span = CALIB_MAX_GYRO_SPAN_DPS * s_gyro_lsb_per_dps[gyro_fs];
+    for (int axis = 0; axis < 3; axis++) {
+        if (gyro_max[axis] - gyro_min[axis] > max_span) {
+            ESP_LOGW(TAG, "⚠️ Movimento durante a calibração (eixo %d)", axis);
+            return false;
+        }
+    }
+
+    float accel_mean[3];
+    for (int axis = 0; axis < 3; axis++) {
+        accel_mean[axis] = (float)accel_sum[axis] / count;
+        calib->gyro_offset[axis] = (int16_t)lrintf((float)gyro_sum[axis] / count);
+    }
+
+    // Nivelado: X e Y deveriam ler zero, então a média é o offset. Inclinado
+    // não dá para separar offset de gravidade; fica só o ganho comum.
+    const float lsb_per_g = s_accel_lsb_per_g[accel_fs];
+    bool level = fabsf(accel_mean[0]) < CALIB_MAX_TILT_G * lsb_per_g &&
+                 fabsf(accel_mean[1]) < CALIB_MAX_TILT_G * lsb_per_g;
+    calib->accel_offset[0] = level ? (int16_t)lrintf(accel_mean[0]) : 0;
+    calib->accel_offset[1] = level ? (int16_t)lrintf(accel_mean[1]) : 0;
+    calib->accel_offset[2] = 0;
+
+    float gx = accel_mean[0] - calib->accel_offset[0];
+    float gy = accel_mean[1] - calib->accel_offset[1];
+    float gz = accel_mean[2];
+    float norm = sqrtf(gx * gx + gy * gy + gz * gz);
+    calib->accel_gain = (norm > 0.5f * lsb_per_g) ? lsb_per_g / norm : 1.0f;
+
+    calib->version = MPU6050_CALIB_VERSION;
+    calib->accel_fs = accel_fs;
+    calib->gyro_fs = gyro_fs;
+    return true;
+}
+
+esp_err_t mpu6050_calib_load(mpu6050_calib_t *calib)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(MPU6050_NVS_NAMESPACE, NVS_READONLY, &handle);
+    if (err != ESP_OK) {
+        return (err == ESP_ERR_NVS_NOT_FOUND) ? ESP_ERR_NOT_FOUND : err;
+    }
+
+    size_t len = sizeof(*calib);
+    err = nvs_get_blob(handle, MPU6050_NVS_KEY, calib, &len);
+    nvs_close(handle);
+
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+    // Formato antigo ou corrompido: trata como ausente
+    if (len != sizeof(*calib) || calib->version != MPU6050_CALIB_VERSION) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_calib_save(const mpu6050_calib_t *calib)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(MPU6050_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    err = nvs_set_blob(handle, MPU6050_NVS_KEY, calib, sizeof(*calib));
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return err;
+}
+
+void mpu6050_scaler_init(mpu6050_scaler_t *scaler, const mpu6050_calib_t *calib,
+                         mpu6050_accel_fs_t accel_fs, mpu6050_gyro_fs_t gyro_fs)
+{
+    // Calibração feita em outra faixa: offsets em LSB não valem mais
+    if (calib != NULL && (calib->accel_fs != accel_fs || calib->gyro_fs != gyro_fs)) {
+        calib = NULL;
+    }
+
+    float accel_gain = calib ? calib->accel_gain : 1.0f;
+    float accel_mms2 = MPU6050_GRAVITY * 1000.0f / s_accel_lsb_per_g[accel_fs] * accel_gain;
+    float gyro_mdps = 1000.0f / s_gyro_lsb_per_dps[gyro_fs];
+
+    for (int axis = 0; axis < 3; axis++) {
+        scaler->offset[axis] = calib ? calib->accel_offset[axis] : 0;
+        scaler->offset[axis + 3] = calib ? calib->gyro_offset[axis] : 0;
+        scaler->gain_q16[axis] = (int32_t)lrintf(accel_mms2 * 65536.0f);
+        scaler->gain_q16[axis + 3] = (int32_t)lrintf(gyro_mdps * 65536.0f);
+    }
+}
+
+void mpu6050_scaler_apply(const mpu6050_scaler_t *scaler, const mpu6050_sample_t *in,
+                          mpu6050_si_sample_t *out, size_t count)
+{
+    const int32_t *off = scaler->offset;
+    const int32_t *gain = scaler->gain_q16;
+
+    // 32x32 -> 64 bits: uma multiplicação longa por eixo, sem float
+    for (size_t i = 0; i < count; i++) {
+        out[i].timestamp_us = in[i].timestamp_us;
+        out[i].accel_mms2[0] = (int32_t)(((int64_t)(in[i].accel[0] - off[0]) * gain[0]) >> 16);
+        out[i].accel_mms2[1] = (int32_t)(((int64_t)(in[i].accel[1] - off[1]) * gain[1]) >> 16);
+        out[i].accel_mms2[2] = (int32_t)(((int64_t)(in[i].accel[2] - off[2]) * gain[2]) >> 16);
+        out[i].gyro_mdps[0] = (int32_t)(((int64_t)(in[i].gyro[0] - off[3]) * gain[3]) >> 16);
+        out[i].gyro_mdps[1] = (int32_t)(((int64_t)(in[i].gyro[1] - off[4]) * gain[4]) >> 16);
+        out[i].gyro_mdps[2] = (int32_t)(((int64_t)(in[i].gyro[2] - off[5]) * gain[5]) >> 16);
+    }
+}
+
+float mpu6050_scaler_accel_mps2_per_lsb(const mpu6050_scaler_t *scaler)
+{
+    return scaler->gain_q16[0] / 65536.0f * 0.001f;
+}
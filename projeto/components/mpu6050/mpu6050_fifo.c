@@ -0,0 +1,192 @@
+#include "mpu6050.h"
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#define TAG "MPU6050_FIFO"
+
+// Maior rajada que cabe na FIFO sem estouro: 85 amostras de 12 bytes
+#define MPU6050_FIFO_MAX_BURST ((MPU6050_FIFO_SIZE / MPU6050_FIFO_SAMPLE_BYTES) * MPU6050_FIFO_SAMPLE_BYTES)
+
+// ----------------------
+// Ring buffer de amostras
+// O dreno escreve e a aplicação lê, possivelmente de tasks diferentes:
+// a seção crítica cobre só a cópia de cada amostra.
+// ----------------------
+static mpu6050_sample_t s_ring[MPU6050_SAMPLE_RING_SIZE];
+static size_t s_ring_head = 0;   // Próxima posição a escrever
+static size_t s_ring_count = 0;
+static portMUX_TYPE s_ring_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint8_t s_burst[MPU6050_FIFO_MAX_BURST];
+static mpu6050_fifo_stats_t s_stats;
+static int64_t s_period_us = 1000;
+static int64_t s_last_ts = 0;   // Instante da última amostra entregue (0 = sem referência)
+static bool s_running = false;
+
+// 🔄 Descarta o conteúdo da FIFO e volta a enchê-la
+static esp_err_t mpu6050_fifo_reset() {
+    esp_err_t err = mpu6050_write_register(MPU6050_REG_USER_CTRL, MPU6050_USER_CTRL_FIFO_RESET);
+    s_stats.transactions++;
+    if (err == ESP_OK) {
+        err = mpu6050_write_register(MPU6050_REG_USER_CTRL, MPU6050_USER_CTRL_FIFO_EN);
+        s_stats.transactions++;
+    }
+    s_last_ts = 0;  // Houve buraco na sequência: reancora os timestamps
+    return err;
+}
+
+esp_err_t mpu6050_fifo_start(const mpu6050_fifo_config_t *config) {
+    uint16_t rate = config->sample_rate_hz;
+    if (rate < 4) rate = 4;
+    if (rate > 1000) rate = 1000;
+    uint8_t dlpf = config->dlpf_cfg;
+    if (dlpf < 1 || dlpf > 6) dlpf = 1;  // Com DLPF 0/7 a taxa interna seria 8 kHz
+
+    // Taxa = 1 kHz / (1 + SMPLRT_DIV)
+    uint8_t div = (uint8_t)(1000 / rate - 1);
+    const uint8_t init_seq[][2] = {
+        {MPU6050_REG_USER_CTRL, 0x00},  // FIFO desligada enquanto configura
+        {MPU6050_REG_FIFO_EN, 0x00},
+        {MPU6050_REG_CONFIG, dlpf},
+        {MPU6050_REG_SMPLRT_DIV, div},
+        {MPU6050_REG_FIFO_EN, MPU6050_FIFO_EN_ACCEL_GYRO},
+    };
+    for (size_t i = 0; i < sizeof(init_seq) / sizeof(init_seq[0]); i++) {
+        esp_err_t err = mpu6050_write_register(init_seq[i][0], init_seq[i][1]);
+        s_stats.transactions++;
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "❌ Falha ao configurar FIFO (reg 0x%02X): %d", init_seq[i][0], err);
+            return err;
+        }
+    }
+
+    s_period_us = 1000 * (div + 1);
+    portENTER_CRITICAL(&s_ring_lock);
+    s_ring_head = 0;
+    s_ring_count = 0;
+    portEXIT_CRITICAL(&s_ring_lock);
+
+    esp_err_t err = mpu6050_fifo_reset();
+    s_running = (err == ESP_OK);
+    if (s_running) {
+        ESP_LOGI(TAG, "✅ FIFO ativa: %u Hz, DLPF %u", 1000u / (div + 1), dlpf);
+    }
+    return err;
+}
+
+esp_err_t mpu6050_fifo_flush() {
+    if (!s_running) {
+        return ESP_OK;
+    }
+    return mpu6050_fifo_reset();
+}
+
+esp_err_t mpu6050_fifo_stop() {
+    s_running = false;
+    esp_err_t err = mpu6050_write_register(MPU6050_REG_USER_CTRL, 0x00);
+    s_stats.transactions++;
+    if (err == ESP_OK) {
+        err = mpu6050_write_register(MPU6050_REG_FIFO_EN, 0x00);
+        s_stats.transactions++;
+    }
+    return err;
+}
+
+// 📥 Copia uma amostra para o ring buffer, sobrescrevendo a mais antiga se cheio
+static void mpu6050_ring_push(const mpu6050_sample_t *sample) {
+    portENTER_CRITICAL(&s_ring_lock);
+    s_ring[s_ring_head] = *sample;
+    s_ring_head = (s_ring_head + 1) % MPU6050_SAMPLE_RING_SIZE;
+    if (s_ring_count < MPU6050_SAMPLE_RING_SIZE) {
+        s_ring_count++;
+    } else {
+        s_stats.ring_dropped++;
+    }
+    portEXIT_CRITICAL(&s_ring_lock);
+}
+
+int mpu6050_fifo_drain() {
+    if (!s_running) {
+        return 0;
+    }
+
+    uint8_t count_raw[2];
+    esp_err_t err = mpu6050_read_registers(MPU6050_REG_FIFO_COUNT_H, count_raw, sizeof(count_raw));
+    s_stats.transactions++;
+    if (err != ESP_OK) {
+        return -1;
+    }
+
+    // A FIFO só chega a 1024 bytes quando estoura (1024 não é múltiplo de 12):
+    // o byte mais antigo foi perdido e o fluxo está desalinhado.
+    uint16_t count = (uint16_t)(count_raw[0] << 8 | count_raw[1]);
+    if (count >= MPU6050_FIFO_SIZE) {
+        s_stats.overflows++;
+        ESP_LOGW(TAG, "⚠️ FIFO estourou; descartando e reiniciando");
+        return (mpu6050_fifo_reset() == ESP_OK) ? 0 : -1;
+    }
+
+    // Só amostras completas; o resto fica para o próximo dreno
+    size_t n = count / MPU6050_FIFO_SAMPLE_BYTES;
+    if (n == 0) {
+        return 0;
+    }
+
+    // FIFO_R_W não incrementa o endereço: uma leitura longa esvazia a fila
+    err = mpu6050_read_registers(MPU6050_REG_FIFO_R_W, s_burst, n * MPU6050_FIFO_SAMPLE_BYTES);
+    s_stats.transactions++;
+    if (err != ESP_OK) {
+        // Parte da rajada pode ter saído da FIFO: não dá para saber onde parou
+        mpu6050_fifo_reset();
+        return -1;
+    }
+
+    // Timestamps contínuos a partir da última amostra; se o relógio do MPU
+    // divergir mais de 4 períodos do esp_timer, reancora no instante atual.
+    int64_t now = esp_timer_get_time();
+    int64_t first = s_last_ts + s_period_us;
+    int64_t expected_last = first + (int64_t)(n - 1) * s_period_us;
+    if (s_last_ts == 0 || llabs(expected_last - now) > 4 * s_period_us) {
+        first = now - (int64_t)(n - 1) * s_period_us;
+    }
+
+    const uint8_t *p = s_burst;
+    mpu6050_sample_t sample;
+    for (size_t i = 0; i < n; i++, p += MPU6050_FIFO_SAMPLE_BYTES) {
+        sample.timestamp_us = first + (int64_t)i * s_period_us;
+        sample.accel[0] = (int16_t)(p[0] << 8 | p[1]);
+        sample.accel[1] = (int16_t)(p[2] << 8 | p[3]);
+        sample.accel[2] = (int16_t)(p[4] << 8 | p[5]);
+        sample.gyro[0]  = (int16_t)(p[6] << 8 | p[7]);
+        sample.gyro[1]  = (int16_t)(p[8] << 8 | p[9]);
+        sample.gyro[2]  = (int16_t)(p[10] << 8 | p[11]);
+        mpu6050_ring_push(&sample);
+    }
+
+    s_last_ts = sample.timestamp_us;
+    s_stats.samples += n;
+    return (int)n;
+}
+
+size_t mpu6050_fifo_pop(mpu6050_sample_t *samples, size_t max) {
+    size_t n = 0;
+    while (n < max) {
+        portENTER_CRITICAL(&s_ring_lock);
+        if (s_ring_count == 0) {
+            portEXIT_CRITICAL(&s_ring_lock);
+            break;
+        }
+        size_t tail = (s_ring_head + MPU6050_SAMPLE_RING_SIZE - s_ring_count) % MPU6050_SAMPLE_RING_SIZE;
+        samples[n++] = s_ring[tail];
+        s_ring_count--;
+        portEXIT_CRITICAL(&s_ring_lock);
+    }
+    return n;
+}
+
+void mpu6050_fifo_get_stats(mpu6050_fifo_stats_t *stats) {
+    *stats = s_stats;
+}
@@ -0,0 +1,167 @@
+#include "mpu6050.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#define TAG "MPU6050_INT"
+
+// INT_PIN_CFG: ativo em alto, push-pull, travado até ler INT_STATUS
+#define MPU6050_INT_PIN_CFG_LATCH 0x20
+
+// ACCEL_CONFIG[2:0]: passa-altas digital usado só pelo detector de movimento
+#define MPU6050_ACCEL_HPF_MASK 0x07
+#define MPU6050_ACCEL_HPF_5HZ  0x01
+
+static mpu6050_int_config_t s_config;
+static bool s_active = false;
+
+// Estado compartilhado com a ISR
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool s_hw_pending = false;     // Borda real: INT_STATUS precisa ser lido
+static volatile uint8_t s_sim_status = 0;      // Bits injetados por mpu6050_int_simulate()
+static volatile int64_t s_edge_time_us = 0;    // Instante da borda mais antiga ainda não atendida
+static mpu6050_int_stats_t s_stats;
+
+// 🔔 ISR do pino INT: só registra a borda e acorda a task
+static void IRAM_ATTR mpu6050_int_isr(void *arg) {
+    BaseType_t woken = pdFALSE;
+
+    portENTER_CRITICAL_ISR(&s_lock);
+    if (!s_hw_pending && s_sim_status == 0) {
+        s_edge_time_us = esp_timer_get_time();
+    }
+    s_hw_pending = true;
+    s_stats.interrupts++;
+    portEXIT_CRITICAL_ISR(&s_lock);
+
+    vTaskNotifyGiveFromISR(s_config.notify_task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+esp_err_t mpu6050_int_start(const mpu6050_int_config_t *config) {
+    if (config->notify_task == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_config = *config;
+
+    // Passa-altas de 5 Hz no detector de movimento: a gravidade não conta
+    uint8_t accel_config;
+    esp_err_t err = mpu6050_read_registers(MPU6050_REG_ACCEL_CONFIG, &accel_config, 1);
+    if (err != ESP_OK) {
+        return err;
+    }
+    accel_config = (accel_config & ~MPU6050_ACCEL_HPF_MASK) | MPU6050_ACCEL_HPF_5HZ;
+
+    const uint8_t init_seq[][2] = {
+        {MPU6050_REG_INT_ENABLE, 0x00},
+        {MPU6050_REG_ACCEL_CONFIG, accel_config},
+        {MPU6050_REG_MOT_THR, config->motion_threshold},
+        {MPU6050_REG_MOT_DUR, config->motion_duration_ms},
+        {MPU6050_REG_INT_PIN_CFG, MPU6050_INT_PIN_CFG_LATCH},
+    };
+    for (size_t i = 0; i < sizeof(init_seq) / sizeof(init_seq[0]); i++) {
+        err = mpu6050_write_register(init_seq[i][0], init_seq[i][1]);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "❌ Falha ao configurar INT (reg 0x%02X): %d", init_seq[i][0], err);
+            return err;
+        }
+    }
+
+    if (!s_active) {
+        gpio_config_t io_conf = {
+            .pin_bit_mask = (1ULL << config->gpio),
+            .mode = GPIO_MODE_INPUT,
+            .pull_up_en = GPIO_PULLUP_DISABLE,
+            .pull_down_en = GPIO_PULLDOWN_ENABLE,  // Pino solto não gera bordas falsas
+            .intr_type = GPIO_INTR_POSEDGE,
+        };
+        gpio_config(&io_conf);
+
+        // O serviço pode já ter sido instalado por outra parte da aplicação
+        err = gpio_install_isr_service(0);
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+            return err;
+        }
+        err = gpio_isr_handler_add(config->gpio, mpu6050_int_isr, NULL);
+        if (err != ESP_OK) {
+            return err;
+        }
+        s_active = true;
+    }
+
+    // Descarta um INT travado de antes da configuração e só então habilita
+    uint8_t status;
+    mpu6050_read_registers(MPU6050_REG_INT_STATUS, &status, 1);
+    err = mpu6050_write_register(MPU6050_REG_INT_ENABLE, config->enable_mask);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "✅ INT no GPIO %d (máscara 0x%02X, limiar %u x 2 mg)",
+                 config->gpio, config->enable_mask, config->motion_threshold);
+    }
+    return err;
+}
+
+esp_err_t mpu6050_int_stop() {
+    if (s_active) {
+        gpio_isr_handler_remove(s_config.gpio);
+        s_active = false;
+    }
+    return mpu6050_write_register(MPU6050_REG_INT_ENABLE, 0x00);
+}
+
+void mpu6050_int_simulate(uint8_t status) {
+    portENTER_CRITICAL(&s_lock);
+    if (!s_hw_pending && s_sim_status == 0) {
+        s_edge_time_us = esp_timer_get_time();
+    }
+    s_sim_status |= status;
+    s_stats.interrupts++;
+    portEXIT_CRITICAL(&s_lock);
+
+    if (s_config.notify_task != NULL) {
+        xTaskNotifyGive(s_config.notify_task);
+    }
+}
+
+esp_err_t mpu6050_int_wait(TickType_t timeout, uint8_t *status) {
+    if (ulTaskNotifyTake(pdTRUE, timeout) == 0) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    bool hw = s_hw_pending;
+    uint8_t bits = s_sim_status;
+    int64_t edge_us = s_edge_time_us;
+    s_hw_pending = false;
+    s_sim_status = 0;
+    portEXIT_CRITICAL(&s_lock);
+
+    if (hw) {
+        // Ler INT_STATUS também solta o pino INT travado
+        uint8_t hw_bits;
+        esp_err_t err = mpu6050_read_registers(MPU6050_REG_INT_STATUS, &hw_bits, 1);
+        if (err != ESP_OK) {
+            return err;
+        }
+        bits |= hw_bits;
+    }
+
+    if (bits & MPU6050_INT_MOTION) s_stats.motion_events++;
+    if (bits & MPU6050_INT_DATA_RDY) s_stats.data_ready_events++;
+    if (bits & MPU6050_INT_FIFO_OFLOW) s_stats.fifo_overflows++;
+
+    uint32_t latency = (uint32_t)(esp_timer_get_time() - edge_us);
+    s_stats.last_latency_us = latency;
+    if (latency > s_stats.max_latency_us) {
+        s_stats.max_latency_us = latency;
+    }
+
+    *status = bits;
+    return ESP_OK;
+}
+
+void mpu6050_int_get_stats(mpu6050_int_stats_t *stats) {
+    portENTER_CRITICAL(&s_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_lock);
+}
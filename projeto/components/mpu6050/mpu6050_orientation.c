@@ -0,0 +1,161 @@
+#include "mpu6050.h"
+#include <string.h>
+#include <math.h>
+
+#define RAD_TO_DEG 57.29577951f
+#define HALF_PI 1.57079633f
+#define PI_F 3.14159265f
+
+// ⚡ 1/sqrt(x) pelo truque do expoente + uma iteração de Newton (~0,2 %)
+float mpu6050_fast_inv_sqrt(float x)
+{
+    float half = 0.5f * x;
+    uint32_t i;
+    memcpy(&i, &x, sizeof(i));
+    i = 0x5f3759df - (i >> 1);
+    memcpy(&x, &i, sizeof(x));
+    return x * (1.5f - half * x * x);
+}
+
+// ⚡ atan2 com polinômio de 7ª ordem em [0, 1] (erro ~2e-4 rad, 0,01°)
+float mpu6050_fast_atan2(float y, float x)
+{
+    float ax = fabsf(x);
+    float ay = fabsf(y);
+    float mx = (ax > ay) ? ax : ay;
+    float mn = (ax > ay) ? ay : ax;
+    if (mx == 0.0f) {
+        return 0.0f;
+    }
+
+    float a = mn / mx;
+    float s = a * a;
+    float r = ((-0.0464964749f * s + 0.15931422f) * s - 0.327622764f) * s * a + a;
+
+    if (ay > ax) r = HALF_PI - r;
+    if (x < 0.0f) r = PI_F - r;
+    if (y < 0.0f) r = -r;
+    return r;
+}
+
+void mpu6050_mahony_init(mpu6050_mahony_t *filter, float sample_rate_hz, float kp, float ki,
+                         mpu6050_gyro_fs_t gyro_fs)
+{
+    memset(filter, 0, sizeof(*filter));
+    filter->q[0] = 1.0f;
+    filter->kp = kp;
+    filter->ki = ki;
+    filter->dt = 1.0f / sample_rate_hz;
+    filter->gyro_scale = (1.0f / mpu6050_gyro_lsb_per_dps(gyro_fs)) / RAD_TO_DEG;
+}
+
+void mpu6050_mahony_set_bias(mpu6050_mahony_t *filter, const int16_t gyro_offset[3])
+{
+    for (int axis = 0; axis < 3; axis++) {
+        filter->gyro_bias[axis] = gyro_offset[axis];
+    }
+    filter->integral[0] = filter->integral[1] = filter->integral[2] = 0.0f;
+}
+
+// Alinha o quatérnio com a gravidade (yaw = 0) a partir de uma amostra
+static void mahony_align(mpu6050_mahony_t *filter, float ax, float ay, float az)
+{
+    float roll = mpu6050_fast_atan2(ay, az);
+    float pitch = mpu6050_fast_atan2(-ax, sqrtf(ay * ay + az * az));
+    float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+    float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+    filter->q[0] = cr * cp;
+    filter->q[1] = sr * cp;
+    filter->q[2] = cr * sp;
+    filter->q[3] = -sr * sp;
+    filter->initialized = true;
+}
+
+void mpu6050_mahony_update(mpu6050_mahony_t *filter, const mpu6050_sample_t *sample)
+{
+    float ax = sample->accel[0];
+    float ay = sample->accel[1];
+    float az = sample->accel[2];
+
+    if (!filter->initialized) {
+        if (ax == 0.0f && ay == 0.0f && az == 0.0f) {
+            return;
+        }
+        mahony_align(filter, ax, ay, az);
+        return;
+    }
+
+    float gx = (sample->gyro[0] - filter->gyro_bias[0]) * filter->gyro_scale;
+    float gy = (sample->gyro[1] - filter->gyro_bias[1]) * filter->gyro_scale;
+    float gz = (sample->gyro[2] - filter->gyro_bias[2]) * filter->gyro_scale;
+
+    float q0 = filter->q[0], q1 = filter->q[1], q2 = filter->q[2], q3 = filter->q[3];
+
+    // Correção pela gravidade (só com aceleração válida)
+    float norm2 = ax * ax + ay * ay + az * az;
+    if (norm2 > 0.0f) {
+        float inv = mpu6050_fast_inv_sqrt(norm2);
+        ax *= inv;
+        ay *= inv;
+        az *= inv;
+
+        // Direção da gravidade prevista pelo quatérnio atual
+        float vx = 2.0f * (q1 * q3 - q0 * q2);
+        float vy = 2.0f * (q0 * q1 + q2 * q3);
+        float vz = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+
+        // Erro = medida x prevista
+        float ex = ay * vz - az * vy;
+        float ey = az * vx - ax * vz;
+        float ez = ax * vy - ay * vx;
+
+        if (filter->ki > 0.0f) {
+            filter->integral[0] += filter->ki * ex * filter->dt;
+            filter->integral[1] += filter->ki * ey * filter->dt;
+            filter->integral[2] += filter->ki * ez * filter->dt;
+            gx += filter->integral[0];
+            gy += filter->integral[1];
+            gz += filter->integral[2];
+        }
+        gx += filter->kp * ex;
+        gy += filter->kp * ey;
+        gz += filter->kp * ez;
+    }
+
+    // q' = q + 0.5 * q ⊗ (0, g) * dt
+    float h = 0.5f * filter->dt;
+    gx *= h;
+    gy *= h;
+    gz *= h;
+    float n0 = q0 - q1 * gx - q2 * gy - q3 * gz;
+    float n1 = q1 + q0 * gx + q2 * gz - q3 * gy;
+    float n2 = q2 + q0 * gy - q1 * gz + q3 * gx;
+    float n3 = q3 + q0 * gz + q1 * gy - q2 * gx;
+
+    float inv = mpu6050_fast_inv_sqrt(n0 * n0 + n1 * n1 + n2 * n2 + n3 * n3);
+    filter->q[0] = n0 * inv;
+    filter->q[1] = n1 * inv;
+    filter->q[2] = n2 * inv;
+    filter->q[3] = n3 * inv;
+}
+
+void mpu6050_mahony_get_euler(const mpu6050_mahony_t *filter, float *roll, float *pitch, float *yaw)
+{
+    float q0 = filter->q[0], q1 = filter->q[1], q2 = filter->q[2], q3 = filter->q[3];
+
+    if (roll) {
+        *roll = mpu6050_fast_atan2(2.0f * (q0 * q1 + q2 * q3), 1.0f - 2.0f * (q1 * q1 + q2 * q2)) * RAD_TO_DEG;
+    }
+    if (pitch) {
+        // asin(s) = atan2(s, sqrt(1 - s²)), sem chamar asinf
+        float s = 2.0f * (q0 * q2 - q3 * q1);
+        if (s > 1.0f) s = 1.0f;
+        if (s < -1.0f) s = -1.0f;
+        float c2 = 1.0f - s * s;
+        float c = (c2 > 0.0f) ? c2 * mpu6050_fast_inv_sqrt(c2) : 0.0f;
+        *pitch = mpu6050_fast_atan2(s, c) * RAD_TO_DEG;
+    }
+    if (yaw) {
+        *yaw = mpu6050_fast_atan2(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3)) * RAD_TO_DEG;
+    }
+}
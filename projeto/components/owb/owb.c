@@ -110,10 +110,11 @@ static uint8_t _calc_crc_block(uint8_t crc, const uint8_t * buffer, size_t len)
 }
 
 /**
+ * @param[in] command OWB_ROM_SEARCH for all devices, OWB_ROM_SEARCH_ALARM for alarmed devices only
  * @param[out] is_found true if a device was found, false if not
  * @return status
  */
-static owb_status _search(const OneWireBus * bus, OneWireBus_SearchState * state, bool * is_found)
+static owb_status _search(const OneWireBus * bus, OneWireBus_SearchState * state, uint8_t command, bool * is_found)
 {
     // Based on https://www.maximintegrated.com/en/app-notes/index.mvp/id/187
 
@@ -146,7 +147,7 @@ static owb_status _search(const OneWireBus * bus, OneWireBus_SearchState * state
         }
 
         // issue the search command
-        bus->driver->write_bits(bus, OWB_ROM_SEARCH, 8);
+        bus->driver->write_bits(bus, command, 8);
 
         // loop to do the search
         do
@@ -323,6 +324,40 @@ owb_status owb_use_parasitic_power(OneWireBus * bus, bool use_parasitic_power)
     return status;
 }
 
+owb_status owb_use_overdrive(OneWireBus * bus, bool use_overdrive)
+{
+    owb_status status = OWB_STATUS_NOT_SET;
+
+    if (!bus)
+    {
+        status = OWB_STATUS_PARAMETER_NULL;
+    }
+    else if (!_is_init(bus))
+    {
+        status = OWB_STATUS_NOT_INITIALIZED;
+    }
+    else if (use_overdrive && !bus->driver->set_speed)
+    {
+        status = OWB_STATUS_NOT_SUPPORTED;
+    }
+    else
+    {
+        // Let the driver refuse overdrive (e.g. timing it cannot generate), then go back to standard speed
+        status = use_overdrive ? bus->driver->set_speed(bus, true) : OWB_STATUS_OK;
+        if (bus->driver->set_speed)
+        {
+            bus->driver->set_speed(bus, false);
+        }
+        if (status == OWB_STATUS_OK)
+        {
+            bus->use_overdrive = use_overdrive;
+            ESP_LOGD(TAG, "use_overdrive %d", bus->use_overdrive);
+        }
+    }
+
+    return status;
+}
+
 owb_status owb_use_strong_pullup_gpio(OneWireBus * bus, gpio_num_t gpio)
 {
     owb_status status = OWB_STATUS_NOT_SET;
@@ -437,7 +472,7 @@ owb_status owb_verify_rom(const OneWireBus * bus, OneWireBus_ROMCode rom_code, b
         };
 
         bool is_found = false;
-        _search(bus, &state, &is_found);
+        _search(bus, &state, OWB_ROM_SEARCH, &is_found);
         if (is_found)
         {
             result = true;
@@ -537,11 +572,18 @@ owb_status owb_read_bytes(const OneWireBus * bus, uint8_t * buffer, unsigned int
     }
     else
     {
-        for (int i = 0; i < len; ++i)
+        if (bus->driver->read_bytes)
         {
-            uint8_t out;
-            bus->driver->read_bits(bus, &out, 8);
-            buffer[i] = out;
+            bus->driver->read_bytes(bus, buffer, len);
+        }
+        else
+        {
+            for (int i = 0; i < len; ++i)
+            {
+                uint8_t out;
+                bus->driver->read_bits(bus, &out, 8);
+                buffer[i] = out;
+            }
         }
 
         ESP_LOGD(TAG, "owb_read_bytes, len %d:", len);
@@ -614,9 +656,16 @@ owb_status owb_write_bytes(const OneWireBus * bus, const uint8_t * buffer, size_
         ESP_LOGD(TAG, "owb_write_bytes, len %d:", len);
         ESP_LOG_BUFFER_HEX_LEVEL(TAG, buffer, len, ESP_LOG_DEBUG);
 
-        for (int i = 0; i < len; i++)
+        if (bus->driver->write_bytes)
         {
-            bus->driver->write_bits(bus, buffer[i], 8);
+            bus->driver->write_bytes(bus, buffer, len);
+        }
+        else
+        {
+            for (int i = 0; i < len; i++)
+            {
+                bus->driver->write_bits(bus, buffer[i], 8);
+            }
         }
 
         status = OWB_STATUS_OK;
@@ -625,6 +674,150 @@ owb_status owb_write_bytes(const OneWireBus * bus, const uint8_t * buffer, size_
     return status;
 }
 
+owb_status owb_transaction(const OneWireBus * bus, const uint8_t * tx, size_t tx_len, uint8_t * rx, size_t rx_len, bool * is_present)
+{
+    owb_status status = OWB_STATUS_NOT_SET;
+
+    if (!bus || !is_present || (tx_len && !tx) || (rx_len && !rx))
+    {
+        status = OWB_STATUS_PARAMETER_NULL;
+    }
+    else if (!_is_init(bus))
+    {
+        status = OWB_STATUS_NOT_INITIALIZED;
+    }
+    else if (bus->driver->transaction)
+    {
+        status = bus->driver->transaction(bus, tx, tx_len, rx, rx_len, is_present);
+    }
+    else
+    {
+        status = owb_reset(bus, is_present);
+        if (status == OWB_STATUS_OK && *is_present)
+        {
+            if (tx_len)
+            {
+                status = owb_write_bytes(bus, tx, tx_len);
+            }
+            if (status == OWB_STATUS_OK && rx_len)
+            {
+                status = owb_read_bytes(bus, rx, rx_len);
+            }
+        }
+    }
+
+    return status;
+}
+
+owb_status owb_set_overdrive(const OneWireBus * bus, bool overdrive)
+{
+    owb_status status = OWB_STATUS_NOT_SET;
+
+    if (!bus)
+    {
+        status = OWB_STATUS_PARAMETER_NULL;
+    }
+    else if (!_is_init(bus))
+    {
+        status = OWB_STATUS_NOT_INITIALIZED;
+    }
+    else if (!bus->driver->set_speed)
+    {
+        status = overdrive ? OWB_STATUS_NOT_SUPPORTED : OWB_STATUS_OK;
+    }
+    else
+    {
+        status = bus->driver->set_speed(bus, overdrive);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Standard-speed reset and ROM command, then switch to overdrive speed.
+ *        Devices change speed right after the command byte, so anything that
+ *        follows it (the ROM code for Overdrive Match) goes at overdrive speed.
+ */
+static owb_status _overdrive_address(const OneWireBus * bus, uint8_t command, const OneWireBus_ROMCode * rom_code, bool * is_present)
+{
+    owb_status status = OWB_STATUS_NOT_SET;
+
+    if (!bus || !is_present)
+    {
+        status = OWB_STATUS_PARAMETER_NULL;
+    }
+    else if (!_is_init(bus))
+    {
+        status = OWB_STATUS_NOT_INITIALIZED;
+    }
+    else if (!bus->use_overdrive || !bus->driver->set_speed)
+    {
+        status = OWB_STATUS_NOT_SUPPORTED;
+    }
+    else
+    {
+        status = bus->driver->set_speed(bus, false);
+        if (status == OWB_STATUS_OK)
+        {
+            status = bus->driver->reset(bus, is_present);
+        }
+        if (status == OWB_STATUS_OK && *is_present)
+        {
+            status = owb_write_byte(bus, command);
+            if (status == OWB_STATUS_OK)
+            {
+                status = bus->driver->set_speed(bus, true);
+            }
+            if (status == OWB_STATUS_OK && rom_code)
+            {
+                status = owb_write_bytes(bus, rom_code->bytes, sizeof(rom_code->bytes));
+            }
+        }
+    }
+
+    return status;
+}
+
+owb_status owb_overdrive_skip(const OneWireBus * bus, bool * is_present)
+{
+    return _overdrive_address(bus, OWB_ROM_OVERDRIVE_SKIP, NULL, is_present);
+}
+
+owb_status owb_overdrive_match(const OneWireBus * bus, OneWireBus_ROMCode rom_code, bool * is_present)
+{
+    return _overdrive_address(bus, OWB_ROM_OVERDRIVE_MATCH, &rom_code, is_present);
+}
+
+owb_status owb_overdrive_probe(const OneWireBus * bus, OneWireBus_ROMCode rom_code, bool * supported)
+{
+    owb_status status = OWB_STATUS_NOT_SET;
+    bool is_present = false;
+
+    if (!supported)
+    {
+        return OWB_STATUS_PARAMETER_NULL;
+    }
+    *supported = false;
+
+    status = owb_overdrive_match(bus, rom_code, &is_present);
+    if (status == OWB_STATUS_OK && is_present)
+    {
+        // A standard-speed device ignored the match; it cannot answer a reset this short
+        status = bus->driver->reset(bus, supported);
+    }
+    if (status != OWB_STATUS_PARAMETER_NULL && status != OWB_STATUS_NOT_INITIALIZED
+        && bus->driver->set_speed)
+    {
+        // A standard reset returns the device to standard speed
+        bool any = false;
+        bus->driver->set_speed(bus, false);
+        bus->driver->reset(bus, &any);
+    }
+    ESP_LOGD(TAG, "overdrive probe: %ssupported", *supported ? "" : "not ");
+
+    return status;
+}
+
 owb_status owb_write_rom_code(const OneWireBus * bus, OneWireBus_ROMCode rom_code)
 {
     owb_status status = OWB_STATUS_NOT_SET;
@@ -656,7 +849,7 @@ uint8_t owb_crc8_bytes(uint8_t crc, const uint8_t * data, size_t len)
     return _calc_crc_block(crc, data, len);
 }
 
-owb_status owb_search_first(const OneWireBus * bus, OneWireBus_SearchState * state, bool * found_device)
+static owb_status _search_first(const OneWireBus * bus, OneWireBus_SearchState * state, uint8_t command, bool * found_device)
 {
     bool result;
     owb_status status = OWB_STATUS_NOT_SET;
@@ -675,7 +868,7 @@ owb_status owb_search_first(const OneWireBus * bus, OneWireBus_SearchState * sta
         state->last_discrepancy = 0;
         state->last_family_discrepancy = 0;
         state->last_device_flag = false;
-        _search(bus, state, &result);
+        _search(bus, state, command, &result);
         status = OWB_STATUS_OK;
 
         *found_device = result;
@@ -684,7 +877,7 @@ owb_status owb_search_first(const OneWireBus * bus, OneWireBus_SearchState * sta
     return status;
 }
 
-owb_status owb_search_next(const OneWireBus * bus, OneWireBus_SearchState * state, bool * found_device)
+static owb_status _search_next(const OneWireBus * bus, OneWireBus_SearchState * state, uint8_t command, bool * found_device)
 {
     owb_status status = OWB_STATUS_NOT_SET;
     bool result = false;
@@ -699,7 +892,7 @@ owb_status owb_search_next(const OneWireBus * bus, OneWireBus_SearchState * stat
     }
     else
     {
-        _search(bus, state, &result);
+        _search(bus, state, command, &result);
         status = OWB_STATUS_OK;
 
         *found_device = result;
@@ -708,6 +901,26 @@ owb_status owb_search_next(const OneWireBus * bus, OneWireBus_SearchState * stat
     return status;
 }
 
+owb_status owb_search_first(const OneWireBus * bus, OneWireBus_SearchState * state, bool * found_device)
+{
+    return _search_first(bus, state, OWB_ROM_SEARCH, found_device);
+}
+
+owb_status owb_search_next(const OneWireBus * bus, OneWireBus_SearchState * state, bool * found_device)
+{
+    return _search_next(bus, state, OWB_ROM_SEARCH, found_device);
+}
+
+owb_status owb_search_alarm_first(const OneWireBus * bus, OneWireBus_SearchState * state, bool * found_device)
+{
+    return _search_first(bus, state, OWB_ROM_SEARCH_ALARM, found_device);
+}
+
+owb_status owb_search_alarm_next(const OneWireBus * bus, OneWireBus_SearchState * state, bool * found_device)
+{
+    return _search_next(bus, state, OWB_ROM_SEARCH_ALARM, found_device);
+}
+
 char * owb_string_from_rom_code(OneWireBus_ROMCode rom_code, char * buffer, size_t len)
 {
     for (int i = sizeof(rom_code.bytes) - 1; i >= 0; i--)
@@ -53,6 +53,8 @@ extern "C" {
 #define OWB_ROM_MATCH         0x55  ///< Address a specific device on the bus by ROM
 #define OWB_ROM_SKIP          0xCC  ///< Address all devices on the bus simultaneously
 #define OWB_ROM_SEARCH_ALARM  0xEC  ///< Address all devices on the bus with a set alarm flag
+#define OWB_ROM_OVERDRIVE_SKIP  0x3C  ///< Address all devices on the bus and switch overdrive-capable ones to overdrive speed
+#define OWB_ROM_OVERDRIVE_MATCH 0x69  ///< Address a specific device by ROM and switch it to overdrive speed
 
 #define OWB_ROM_CODE_STRING_LENGTH (17)  ///< Typical length of OneWire bus ROM ID as ASCII hex string, including null terminator
 
@@ -70,6 +72,7 @@ typedef struct
     const struct _OneWireBus_Timing * timing;   ///< Pointer to timing information
     bool use_crc;                               ///< True if CRC checks are to be used when retrieving information from a device on the bus
     bool use_parasitic_power;                   ///< True if parasitic-powered devices are expected on the bus
+    bool use_overdrive;                         ///< True if overdrive speed may be used with devices that support it
     gpio_num_t strong_pullup_gpio;              ///< Set if an external strong pull-up circuit is required
     const struct owb_driver * driver;           ///< Pointer to hardware driver instance
 } OneWireBus;
@@ -119,7 +122,8 @@ typedef enum
     OWB_STATUS_DEVICE_NOT_RESPONDING,  ///< No response received from the addressed device or devices
     OWB_STATUS_CRC_FAILED,             ///< CRC failed on data received from a device or devices
     OWB_STATUS_TOO_MANY_BITS,          ///< Attempt to write an incorrect number of bits to the One Wire Bus
-    OWB_STATUS_HW_ERROR                ///< A hardware error occurred
+    OWB_STATUS_HW_ERROR,               ///< A hardware error occurred
+    OWB_STATUS_NOT_SUPPORTED           ///< The driver cannot perform the requested operation
 } owb_status;
 
 /** NOTE: Driver assumes that (*init) was called prior to any other methods */
@@ -139,6 +143,18 @@ struct owb_driver
 
     /** NOTE: Data is read into the high bits, eg. each bit read is shifted down before the next bit is read */
     owb_status (*read_bits)(const OneWireBus *bus, uint8_t *in, int number_of_bits_to_read);
+
+    /** Optional: write a whole buffer in one transfer, each byte lsb first. NULL falls back to write_bits per byte. */
+    owb_status (*write_bytes)(const OneWireBus *bus, const uint8_t *buffer, size_t len);
+
+    /** Optional: read a whole buffer in one transfer, each byte lsb first. NULL falls back to read_bits per byte. */
+    owb_status (*read_bytes)(const OneWireBus *bus, uint8_t *buffer, size_t len);
+
+    /** Optional: reset, write tx, read rx as one operation. NULL falls back to reset + write_bytes + read_bytes. */
+    owb_status (*transaction)(const OneWireBus *bus, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len, bool *is_present);
+
+    /** Optional: switch slot and reset timing between standard and overdrive speed. NULL means standard speed only. */
+    owb_status (*set_speed)(const OneWireBus *bus, bool overdrive);
 };
 
 /// @cond ignore
@@ -172,6 +188,16 @@ owb_status owb_use_crc(OneWireBus * bus, bool use_crc);
  */
 owb_status owb_use_parasitic_power(OneWireBus * bus, bool use_parasitic_power);
 
+/**
+ * @brief Enable or disable use of overdrive speed with devices that support it.
+ *        The bus always starts, searches and resets at standard speed; overdrive is
+ *        only entered per transaction with owb_overdrive_skip() or owb_overdrive_match().
+ * @param[in] bus Pointer to initialised bus instance.
+ * @param[in] use_overdrive True to enable overdrive, false to disable.
+ * @return status, OWB_STATUS_NOT_SUPPORTED if the driver cannot generate overdrive timing.
+ */
+owb_status owb_use_overdrive(OneWireBus * bus, bool use_overdrive);
+
 /**
  * @brief Enable or disable use of extra GPIO to activate strong pull-up circuit.
  *        This only has effect if parasitic power mode is enabled.
@@ -305,6 +331,86 @@ owb_status owb_search_first(const OneWireBus * bus, OneWireBus_SearchState * sta
  */
 owb_status owb_search_next(const OneWireBus * bus, OneWireBus_SearchState * state, bool *found_device);
 
+/**
+ * @brief Locates the first device on the 1-Wire bus with its alarm flag set, if present.
+ *        Uses the Alarm Search command (0xEC): devices without an active alarm
+ *        do not take part in the search, so an alarm-free bus costs a single pass.
+ * @param[in] bus Pointer to initialised bus instance.
+ * @param[in,out] state Pointer to an existing search state structure.
+ * @param[out] found_device True if an alarmed device is found, false otherwise.
+ *         If a device is found, the ROM Code can be obtained from the state.
+ * @return status
+ */
+owb_status owb_search_alarm_first(const OneWireBus * bus, OneWireBus_SearchState * state, bool *found_device);
+
+/**
+ * @brief Locates the next device on the 1-Wire bus with its alarm flag set, if present,
+ *        starting from the provided state.
+ * @param[in] bus Pointer to initialised bus instance.
+ * @param[in,out] state Pointer to an existing search state structure.
+ * @param[out] found_device True if an alarmed device is found, false otherwise.
+ * @return status
+ */
+owb_status owb_search_alarm_next(const OneWireBus * bus, OneWireBus_SearchState * state, bool *found_device);
+
+/**
+ * @brief Reset the bus, write a sequence of bytes and read a sequence of bytes, as one operation.
+ *        Drivers that support it (owb_rmt) run the whole sequence as a single hardware
+ *        transaction; otherwise it is equivalent to owb_reset + owb_write_bytes + owb_read_bytes.
+ *        Typical use: ROM command + ROM code + function command, then the device response.
+ * @param[in] bus Pointer to initialised bus instance.
+ * @param[in] tx Bytes to write after the reset, may be NULL if tx_len is 0.
+ * @param[in] tx_len Number of bytes to write.
+ * @param[out] rx Buffer for the bytes read after the writes, may be NULL if rx_len is 0.
+ * @param[in] rx_len Number of bytes to read.
+ * @param[out] is_present True if a device answered the reset. If not, the contents of rx are undefined.
+ * @return status
+ */
+owb_status owb_transaction(const OneWireBus * bus, const uint8_t * tx, size_t tx_len, uint8_t * rx, size_t rx_len, bool * is_present);
+
+/**
+ * @brief Switch the driver timing between standard and overdrive speed.
+ *        This only changes how the master times its slots; devices switch speed
+ *        on an Overdrive Skip/Match ROM command and return to standard speed
+ *        on a reset of standard length.
+ * @param[in] bus Pointer to initialised bus instance.
+ * @param[in] overdrive True for overdrive timing, false for standard timing.
+ * @return status
+ */
+owb_status owb_set_overdrive(const OneWireBus * bus, bool overdrive);
+
+/**
+ * @brief Reset at standard speed, send Overdrive Skip ROM (0x3C) and leave the bus
+ *        at overdrive speed. All overdrive-capable devices follow; the others stay
+ *        silent until the next standard reset.
+ * @param[in] bus Pointer to initialised bus instance.
+ * @param[out] is_present True if at least one device answered the reset.
+ * @return status
+ */
+owb_status owb_overdrive_skip(const OneWireBus * bus, bool * is_present);
+
+/**
+ * @brief Reset at standard speed, send Overdrive Match ROM (0x69) and the ROM code,
+ *        and leave the bus at overdrive speed. The ROM code itself is sent at overdrive speed.
+ * @param[in] bus Pointer to initialised bus instance.
+ * @param[in] rom_code ROM code of the device to address.
+ * @param[out] is_present True if at least one device answered the reset.
+ * @return status
+ */
+owb_status owb_overdrive_match(const OneWireBus * bus, OneWireBus_ROMCode rom_code, bool * is_present);
+
+/**
+ * @brief Check whether the device with the given ROM code runs at overdrive speed.
+ *        Addresses it with Overdrive Match ROM and then resets at overdrive speed:
+ *        only a device that switched to overdrive answers that reset.
+ *        The bus is returned to standard speed with a standard reset afterwards.
+ * @param[in] bus Pointer to initialised bus instance.
+ * @param[in] rom_code ROM code of the device to probe.
+ * @param[out] supported True if the device answered at overdrive speed.
+ * @return status
+ */
+owb_status owb_overdrive_probe(const OneWireBus * bus, OneWireBus_ROMCode rom_code, bool * supported);
+
 /**
  * @brief Create a string representation of a ROM code, most significant byte (CRC8) first.
  * @param[in] rom_code The ROM code to convert to string representation.
@@ -328,6 +434,7 @@ owb_status owb_set_strong_pullup(const OneWireBus * bus, bool enable);
 
 #include "owb_gpio.h"
 #include "owb_rmt.h"
+#include "owb_uart.h"
 
 #ifdef __cplusplus
 }
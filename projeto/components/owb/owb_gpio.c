@@ -40,6 +40,10 @@
 #include "driver/gpio.h"
 #include "rom/ets_sys.h"    // for ets_delay_us()
 #include "rom/gpio.h"       // for gpio_pad_select_gpio()
+#include "esp_cpu.h"        // for esp_cpu_get_cycle_count()
+#include "esp_rom_sys.h"    // for esp_rom_get_cpu_ticks_per_us()
+#include "esp_timer.h"      // for esp_timer_get_time()
+#include "hal/gpio_ll.h"    // direct register access for the fast path
 
 #include "owb.h"
 #include "owb_gpio.h"
@@ -67,41 +71,200 @@ struct _OneWireBus_Timing
 };
 /// @endcond
 
-// 1-Wire timing delays (standard) in microseconds.
+// 1-Wire timing delays (standard) in nanoseconds.
 // Labels and values are from https://www.maximintegrated.com/en/app-notes/index.mvp/id/126
 static const struct _OneWireBus_Timing _StandardTiming = {
-        6,    // A - read/write "1" master pull DQ low duration
-        64,   // B - write "0" master pull DQ low duration
-        60,   // C - write "1" master pull DQ high duration
-        10,   // D - write "0" master pull DQ high duration
-        9,    // E - read master pull DQ high duration
-        55,   // F - complete read timeslot + 10ms recovery
-        0,    // G - wait before reset
-        480,  // H - master pull DQ low duration
-        70,   // I - master pull DQ high duration
-        410,  // J - complete presence timeslot + recovery
+        6000,    // A - read/write "1" master pull DQ low duration
+        64000,   // B - write "0" master pull DQ low duration
+        60000,   // C - write "1" master pull DQ high duration
+        10000,   // D - write "0" master pull DQ high duration
+        9000,    // E - read master pull DQ high duration
+        55000,   // F - complete read timeslot + 10ms recovery
+        0,       // G - wait before reset
+        480000,  // H - master pull DQ low duration
+        70000,   // I - master pull DQ high duration
+        410000,  // J - complete presence timeslot + recovery
 };
 
-static void _us_delay(uint32_t time_us)
+// 1-Wire timing delays (overdrive) in nanoseconds, same source.
+// Only the fast path can produce them (see _set_speed()).
+static const struct _OneWireBus_Timing _OverdriveTiming = {
+        1000,    // A
+        7500,    // B
+        7500,    // C
+        2500,    // D
+        1000,    // E
+        7000,    // F
+        2500,    // G
+        70000,   // H
+        8500,    // I
+        40000,   // J
+};
+
+static void _us_delay(uint32_t time_ns)
 {
-    ets_delay_us(time_us);
+    ets_delay_us(time_ns / 1000);
 }
 
 /// @cond ignore
 #define info_from_bus(owb) container_of(owb, owb_gpio_driver_info, bus)
 /// @endcond
 
+/**
+ * @brief Busy-wait on the CPU cycle counter until `time_ns` after `start`.
+ *        No ROM call, and the time already spent since `start` counts.
+ *        The counter is per core, so this is only valid inside portENTER_CRITICAL,
+ *        where the task cannot migrate; use _timer_delay() with interrupts on.
+ */
+static inline void _cycle_delay_from(const owb_gpio_driver_info * i, uint32_t start, uint32_t time_ns)
+{
+    uint32_t cycles = time_ns * i->ticks_per_us / 1000;
+    while ((uint32_t)(esp_cpu_get_cycle_count() - start) < cycles)
+    {
+    }
+}
+
+/**
+ * @brief Busy-wait on esp_timer, for the waits that run with interrupts on.
+ *        The task may be preempted and resumed on the other core mid-wait; the
+ *        system timer is shared by both cores, the cycle counter is not.
+ *        Rounds up to whole microseconds plus one tick, so the wait never ends
+ *        early (it can only stretch, which these waits tolerate).
+ */
+static inline void _timer_delay(uint32_t time_ns)
+{
+    if (time_ns == 0)
+    {
+        return;
+    }
+    int64_t us = (time_ns + 999) / 1000;
+    int64_t start = esp_timer_get_time();
+    while (esp_timer_get_time() - start <= us)
+    {
+    }
+}
+
+/**
+ * @brief Record how long interrupts were off (critical section entered at `start`).
+ */
+static inline void _account_critical(owb_gpio_driver_info * i, uint32_t start)
+{
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+    i->critical_sections++;
+    i->total_critical_cycles += cycles;
+    if (cycles > i->max_critical_cycles)
+    {
+        i->max_critical_cycles = cycles;
+    }
+}
+
+/**
+ * @brief Fast path: the pin is open drain (set up once), so writing 0 drives the bus
+ *        low and writing 1 releases it; the level can be read back at any time.
+ *        Only the part of each slot whose timing matters runs with interrupts off.
+ */
+static inline void _pin_low(const owb_gpio_driver_info * i)
+{
+    gpio_ll_set_level(&GPIO, i->gpio, 0);
+}
+
+static inline void _pin_release(const owb_gpio_driver_info * i)
+{
+    gpio_ll_set_level(&GPIO, i->gpio, 1);
+}
+
+static inline int _pin_get(const owb_gpio_driver_info * i)
+{
+    return gpio_ll_get_level(&GPIO, i->gpio);
+}
+
+static owb_status _reset_fast(const OneWireBus * bus, bool * is_present)
+{
+    owb_gpio_driver_info *i = info_from_bus(bus);
+
+    uint32_t start;
+    _timer_delay(bus->timing->G);
+    if (bus->timing == &_OverdriveTiming)
+    {
+        // Overdrive tRSTL is 48-80us: a stretched pulse sends devices back to
+        // standard speed, so the low pulse is timed with interrupts off as well
+        portENTER_CRITICAL(&i->lock);
+        start = esp_cpu_get_cycle_count();
+        _pin_low(i);
+        _cycle_delay_from(i, start, bus->timing->H);
+    }
+    else
+    {
+        // A longer standard reset pulse is harmless: no need to hold interrupts off for it
+        _pin_low(i);
+        _timer_delay(bus->timing->H);
+        portENTER_CRITICAL(&i->lock);
+        start = esp_cpu_get_cycle_count();
+    }
+
+    // Release -> presence sample must not stretch past the presence pulse
+    uint32_t release = esp_cpu_get_cycle_count();
+    _pin_release(i);
+    _cycle_delay_from(i, release, bus->timing->I);
+    int level1 = _pin_get(i);
+    portEXIT_CRITICAL(&i->lock);
+    _account_critical(i, start);
+
+    _timer_delay(bus->timing->J);   // Complete the reset sequence recovery
+    int level2 = _pin_get(i);
+
+    *is_present = (level1 == 0) && (level2 == 1);   // Sample for presence pulse from slave
+    ESP_LOGD(TAG, "reset: level1 0x%x, level2 0x%x, present %d", level1, level2, *is_present);
+    return OWB_STATUS_OK;
+}
+
+static void _write_bit_fast(const OneWireBus * bus, int bit)
+{
+    owb_gpio_driver_info *i = info_from_bus(bus);
+
+    // Only the low pulse is timing critical; the recovery can stretch
+    portENTER_CRITICAL(&i->lock);
+    uint32_t start = esp_cpu_get_cycle_count();
+    _pin_low(i);
+    _cycle_delay_from(i, start, bit ? bus->timing->A : bus->timing->C);
+    _pin_release(i);
+    portEXIT_CRITICAL(&i->lock);
+    _account_critical(i, start);
+
+    _timer_delay(bit ? bus->timing->B : bus->timing->D);
+}
+
+static int _read_bit_fast(const OneWireBus * bus)
+{
+    owb_gpio_driver_info *i = info_from_bus(bus);
+
+    // Low pulse + sample within 15us of the falling edge
+    portENTER_CRITICAL(&i->lock);
+    uint32_t start = esp_cpu_get_cycle_count();
+    _pin_low(i);
+    _cycle_delay_from(i, start, bus->timing->A);
+    _pin_release(i);
+    _cycle_delay_from(i, start, bus->timing->A + bus->timing->E);
+    int level = _pin_get(i);
+    portEXIT_CRITICAL(&i->lock);
+    _account_critical(i, start);
+
+    _timer_delay(bus->timing->F);   // Complete the timeslot and 10us recovery
+    return level & 0x01;
+}
+
 /**
  * @brief Generate a 1-Wire reset (initialization).
  * @param[in] bus Initialised bus instance.
  * @param[out] is_present true if device is present, otherwise false.
  * @return status
  */
-static owb_status _reset(const OneWireBus * bus, bool * is_present)
+static owb_status _reset_legacy(const OneWireBus * bus, bool * is_present)
 {
     bool present = false;
     portMUX_TYPE timeCriticalMutex = portMUX_INITIALIZER_UNLOCKED;
     portENTER_CRITICAL(&timeCriticalMutex);
+    uint32_t start = esp_cpu_get_cycle_count();
 
     owb_gpio_driver_info *i = info_from_bus(bus);
 
@@ -136,6 +299,7 @@ static owb_status _reset(const OneWireBus * bus, bool * is_present)
 #endif
 
     portEXIT_CRITICAL(&timeCriticalMutex);
+    _account_critical(i, start);
 
     present = (level1 == 0) && (level2 == 1);   // Sample for presence pulse from slave
     ESP_LOGD(TAG, "reset: level1 0x%x, level2 0x%x, present %d", level1, level2, present);
@@ -150,7 +314,7 @@ static owb_status _reset(const OneWireBus * bus, bool * is_present)
  * @param[in] bus Initialised bus instance.
  * @param[in] bit The value to send.
  */
-static void _write_bit(const OneWireBus * bus, int bit)
+static void _write_bit_legacy(const OneWireBus * bus, int bit)
 {
     int delay1 = bit ? bus->timing->A : bus->timing->C;
     int delay2 = bit ? bus->timing->B : bus->timing->D;
@@ -158,6 +322,7 @@ static void _write_bit(const OneWireBus * bus, int bit)
 
     portMUX_TYPE timeCriticalMutex = portMUX_INITIALIZER_UNLOCKED;
     portENTER_CRITICAL(&timeCriticalMutex);
+    uint32_t start = esp_cpu_get_cycle_count();
 
     gpio_set_direction(i->gpio, GPIO_MODE_OUTPUT);
     gpio_set_level(i->gpio, 0);  // Drive DQ low
@@ -166,19 +331,21 @@ static void _write_bit(const OneWireBus * bus, int bit)
     _us_delay(delay2);
 
     portEXIT_CRITICAL(&timeCriticalMutex);
+    _account_critical(i, start);
 }
 
 /**
  * @brief Read a bit from the 1-Wire bus and return the value, with recovery time.
  * @param[in] bus Initialised bus instance.
  */
-static int _read_bit(const OneWireBus * bus)
+static int _read_bit_legacy(const OneWireBus * bus)
 {
     int result = 0;
     owb_gpio_driver_info *i = info_from_bus(bus);
 
     portMUX_TYPE timeCriticalMutex = portMUX_INITIALIZER_UNLOCKED;
     portENTER_CRITICAL(&timeCriticalMutex);
+    uint32_t start = esp_cpu_get_cycle_count();
 
     gpio_set_direction(i->gpio, GPIO_MODE_OUTPUT);
     gpio_set_level(i->gpio, 0);  // Drive DQ low
@@ -200,12 +367,35 @@ static int _read_bit(const OneWireBus * bus)
     _us_delay(bus->timing->F);   // Complete the timeslot and 10us recovery
 
     portEXIT_CRITICAL(&timeCriticalMutex);
+    _account_critical(i, start);
 
     result = level & 0x01;
 
     return result;
 }
 
+static owb_status _reset(const OneWireBus * bus, bool * is_present)
+{
+    return info_from_bus(bus)->fast ? _reset_fast(bus, is_present) : _reset_legacy(bus, is_present);
+}
+
+static void _write_bit(const OneWireBus * bus, int bit)
+{
+    if (info_from_bus(bus)->fast)
+    {
+        _write_bit_fast(bus, bit);
+    }
+    else
+    {
+        _write_bit_legacy(bus, bit);
+    }
+}
+
+static int _read_bit(const OneWireBus * bus)
+{
+    return info_from_bus(bus)->fast ? _read_bit_fast(bus) : _read_bit_legacy(bus);
+}
+
 /**
  * @brief Write 1-Wire data byte.
  * NOTE: The data is shifted out of the low bits, eg. it is written in the order of lsb to msb
@@ -248,6 +438,47 @@ static owb_status _read_bits(const OneWireBus * bus, uint8_t *out, int number_of
     return OWB_STATUS_OK;
 }
 
+/**
+ * @brief Write a buffer to the bus, lsb of each byte first.
+ *        Bit-banged slots gain nothing from batching; this only saves the per-byte dispatch.
+ */
+static owb_status _write_bytes(const OneWireBus * bus, const uint8_t * buffer, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        _write_bits(bus, buffer[i], 8);
+    }
+    return OWB_STATUS_OK;
+}
+
+/**
+ * @brief Read a buffer from the bus, lsb of each byte first.
+ */
+static owb_status _read_bytes(const OneWireBus * bus, uint8_t * buffer, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        _read_bits(bus, &buffer[i], 8);
+    }
+    return OWB_STATUS_OK;
+}
+
+/**
+ * @brief Switch between standard and overdrive slot timing.
+ *        Overdrive slots are a few microseconds long, below what the legacy path
+ *        (ets_delay_us plus driver calls per edge) can produce.
+ */
+static owb_status _set_speed(const OneWireBus * bus, bool overdrive)
+{
+    owb_gpio_driver_info * i = info_from_bus(bus);
+    if (overdrive && !i->fast)
+    {
+        return OWB_STATUS_NOT_SUPPORTED;
+    }
+    i->bus.timing = overdrive ? &_OverdriveTiming : &_StandardTiming;
+    return OWB_STATUS_OK;
+}
+
 static owb_status _uninitialize(const OneWireBus * bus)
 {
     // Nothing to do here for this driver_info
@@ -260,7 +491,10 @@ static const struct owb_driver gpio_function_table =
     .uninitialize = _uninitialize,
     .reset = _reset,
     .write_bits = _write_bits,
-    .read_bits = _read_bits
+    .read_bits = _read_bits,
+    .write_bytes = _write_bytes,
+    .read_bytes = _read_bytes,
+    .set_speed = _set_speed
 };
 
 OneWireBus* owb_gpio_initialize(owb_gpio_driver_info * driver_info, int gpio)
@@ -271,9 +505,13 @@ OneWireBus* owb_gpio_initialize(owb_gpio_driver_info * driver_info, int gpio)
     driver_info->bus.driver = &gpio_function_table;
     driver_info->bus.timing = &_StandardTiming;
     driver_info->bus.strong_pullup_gpio = GPIO_NUM_NC;
+    portMUX_INITIALIZE(&driver_info->lock);
+    driver_info->ticks_per_us = esp_rom_get_cpu_ticks_per_us();
+    owb_gpio_reset_stats(driver_info);
 
     // platform specific:
     gpio_pad_select_gpio(driver_info->gpio);
+    owb_gpio_use_fast_path(driver_info, true);
 
 #ifdef PHY_DEBUG
     gpio_config_t io_conf;
@@ -287,3 +525,34 @@ OneWireBus* owb_gpio_initialize(owb_gpio_driver_info * driver_info, int gpio)
 
     return &(driver_info->bus);
 }
+
+void owb_gpio_use_fast_path(owb_gpio_driver_info * driver_info, bool fast)
+{
+    if (fast)
+    {
+        // Open drain once: from here on only the output level is touched
+        gpio_set_level(driver_info->gpio, 1);
+        gpio_set_direction(driver_info->gpio, GPIO_MODE_INPUT_OUTPUT_OD);
+    }
+    else
+    {
+        gpio_set_direction(driver_info->gpio, GPIO_MODE_INPUT);
+        driver_info->bus.timing = &_StandardTiming;
+    }
+    driver_info->fast = fast;
+}
+
+void owb_gpio_reset_stats(owb_gpio_driver_info * driver_info)
+{
+    driver_info->critical_sections = 0;
+    driver_info->total_critical_cycles = 0;
+    driver_info->max_critical_cycles = 0;
+}
+
+void owb_gpio_get_stats(const owb_gpio_driver_info * driver_info, owb_gpio_stats_t * stats)
+{
+    uint32_t ticks_per_us = driver_info->ticks_per_us ? driver_info->ticks_per_us : 1;
+    stats->critical_sections = driver_info->critical_sections;
+    stats->max_critical_us = driver_info->max_critical_cycles / ticks_per_us;
+    stats->total_critical_us = driver_info->total_critical_cycles / ticks_per_us;
+}
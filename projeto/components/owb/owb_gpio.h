@@ -37,6 +37,7 @@
 #ifndef OWB_GPIO_H
 #define OWB_GPIO_H
 
+#include "freertos/FreeRTOS.h"
 #include "owb.h"
 
 #ifdef __cplusplus
@@ -50,14 +51,57 @@ typedef struct
 {
     int gpio;         ///< Value of the GPIO connected to the 1-Wire bus
     OneWireBus bus;   ///< OneWireBus instance
+    bool fast;                        ///< Fast path in use (see owb_gpio_use_fast_path())
+    portMUX_TYPE lock;                ///< Spinlock for the timing-critical part of each slot
+    uint32_t ticks_per_us;            ///< CPU cycles per microsecond, for the cycle-counter delay
+    uint32_t critical_sections;       ///< Number of critical sections since the last stats reset
+    uint32_t max_critical_cycles;     ///< Longest critical section, in CPU cycles
+    uint64_t total_critical_cycles;   ///< Sum of all critical sections, in CPU cycles
 } owb_gpio_driver_info;
 
+/**
+ * @brief Time spent with interrupts disabled by the driver.
+ */
+typedef struct
+{
+    uint32_t critical_sections;   ///< Number of critical sections
+    uint32_t max_critical_us;     ///< Worst-case interrupt-off time
+    uint64_t total_critical_us;   ///< Total interrupt-off time
+} owb_gpio_stats_t;
+
 /**
  * @brief Initialise the GPIO driver.
  * @return OneWireBus*, pass this into the other OneWireBus public API functions
  */
 OneWireBus * owb_gpio_initialize(owb_gpio_driver_info *driver_info, int gpio);
 
+/**
+ * @brief Select the slot implementation.
+ *
+ * The fast path (default) configures the pin as open drain once, touches it through
+ * direct register access and keeps interrupts off only for the timing-critical part
+ * of each slot (at most ~70us, for the presence sample; ~80us for an overdrive reset,
+ * whose low pulse has an upper limit). Those parts are timed with the CPU cycle
+ * counter; the waits that run with interrupts on (standard reset pulse, recoveries)
+ * use esp_timer, since the cycle counter is per core and the calling task may
+ * migrate between cores mid-wait. The legacy path reconfigures the pin through the GPIO driver on every slot
+ * and holds interrupts off for whole slots (~960us for a reset).
+ * Both paths record their critical sections, see owb_gpio_get_stats().
+ * Overdrive speed (owb_use_overdrive()) needs the fast path; turning the fast
+ * path off returns the bus to standard timing.
+ */
+void owb_gpio_use_fast_path(owb_gpio_driver_info *driver_info, bool fast);
+
+/**
+ * @brief Clear the critical-section statistics.
+ */
+void owb_gpio_reset_stats(owb_gpio_driver_info *driver_info);
+
+/**
+ * @brief Read the critical-section statistics (interrupt-off time).
+ */
+void owb_gpio_get_stats(const owb_gpio_driver_info *driver_info, owb_gpio_stats_t *stats);
+
 /**
  * @brief Clean up after a call to owb_gpio_initialize()
  */
@@ -0,0 +1,318 @@
+/**
+ * @file
+ * @brief Cache of the ROM codes found on a One Wire Bus, see owb_registry.h.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "nvs.h"
+
+#include "owb.h"
+#include "owb_registry.h"
+
+static const char * TAG = "owb_registry";
+
+// single blob: the ROM codes back to back, 8 bytes each
+#define OWB_REGISTRY_NVS_KEY "roms"
+
+static bool _same_rom(const OneWireBus_ROMCode * a, const OneWireBus_ROMCode * b)
+{
+    return memcmp(a->bytes, b->bytes, sizeof(a->bytes)) == 0;
+}
+
+owb_status owb_registry_init(owb_registry_t * registry, const OneWireBus * bus, const char * nvs_namespace)
+{
+    if (!registry || !bus)
+    {
+        return OWB_STATUS_PARAMETER_NULL;
+    }
+
+    memset(registry, 0, sizeof(*registry));
+    registry->bus = bus;
+    registry->nvs_namespace = nvs_namespace;
+    registry->loaded = (nvs_namespace == NULL);
+    return OWB_STATUS_OK;
+}
+
+void owb_registry_set_verifier(owb_registry_t * registry, owb_registry_verify_fn verify, void * ctx)
+{
+    if (registry)
+    {
+        registry->verify = verify;
+        registry->verify_ctx = ctx;
+    }
+}
+
+owb_status owb_registry_load(owb_registry_t * registry)
+{
+    if (!registry)
+    {
+        return OWB_STATUS_PARAMETER_NULL;
+    }
+    registry->loaded = true;
+    if (!registry->nvs_namespace)
+    {
+        return OWB_STATUS_OK;
+    }
+
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(registry->nvs_namespace, NVS_READONLY, &handle);
+    if (err == ESP_ERR_NVS_NOT_FOUND)
+    {
+        return OWB_STATUS_OK;  // never saved
+    }
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "nvs_open failed: %s", esp_err_to_name(err));
+        return OWB_STATUS_HW_ERROR;
+    }
+
+    OneWireBus_ROMCode roms[OWB_REGISTRY_MAX_DEVICES];
+    size_t len = sizeof(roms);
+    err = nvs_get_blob(handle, OWB_REGISTRY_NVS_KEY, roms, &len);
+    nvs_close(handle);
+    if (err == ESP_ERR_NVS_NOT_FOUND)
+    {
+        return OWB_STATUS_OK;
+    }
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "nvs_get_blob failed: %s", esp_err_to_name(err));
+        return OWB_STATUS_HW_ERROR;
+    }
+
+    registry->count = 0;
+    for (size_t i = 0; i < len / sizeof(OneWireBus_ROMCode); ++i)
+    {
+        // a corrupted entry would only ever fail verification
+        if (owb_crc8_bytes(0, roms[i].bytes, sizeof(roms[i].bytes)) != 0)
+        {
+            ESP_LOGW(TAG, "dropping cached ROM code %u: bad CRC", (unsigned)i);
+            continue;
+        }
+        registry->entries[registry->count].rom_code = roms[i];
+        registry->entries[registry->count].present = false;
+        registry->count++;
+    }
+    ESP_LOGD(TAG, "%u ROM codes loaded", (unsigned)registry->count);
+    return OWB_STATUS_OK;
+}
+
+owb_status owb_registry_save(owb_registry_t * registry)
+{
+    if (!registry)
+    {
+        return OWB_STATUS_PARAMETER_NULL;
+    }
+    if (!registry->nvs_namespace)
+    {
+        return OWB_STATUS_OK;
+    }
+
+    OneWireBus_ROMCode roms[OWB_REGISTRY_MAX_DEVICES];
+    for (size_t i = 0; i < registry->count; ++i)
+    {
+        roms[i] = registry->entries[i].rom_code;
+    }
+
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(registry->nvs_namespace, NVS_READWRITE, &handle);
+    if (err == ESP_OK)
+    {
+        err = nvs_set_blob(handle, OWB_REGISTRY_NVS_KEY, roms, registry->count * sizeof(OneWireBus_ROMCode));
+        if (err == ESP_OK)
+        {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "saving ROM codes failed: %s", esp_err_to_name(err));
+        return OWB_STATUS_HW_ERROR;
+    }
+    ESP_LOGD(TAG, "%u ROM codes saved", (unsigned)registry->count);
+    return OWB_STATUS_OK;
+}
+
+owb_status owb_registry_enumerate(owb_registry_t * registry)
+{
+    if (!registry)
+    {
+        return OWB_STATUS_PARAMETER_NULL;
+    }
+
+    owb_registry_entry_t found[OWB_REGISTRY_MAX_DEVICES];
+    size_t count = 0;
+    OneWireBus_SearchState state = {0};
+    bool is_found = false;
+
+    registry->enumerations++;
+    owb_status status = owb_search_first(registry->bus, &state, &is_found);
+    while (status == OWB_STATUS_OK && is_found)
+    {
+        if (count == OWB_REGISTRY_MAX_DEVICES)
+        {
+            ESP_LOGW(TAG, "more than %d devices on the bus, ignoring the rest", OWB_REGISTRY_MAX_DEVICES);
+            break;
+        }
+        found[count].rom_code = state.rom_code;
+        found[count].present = true;
+        count++;
+        status = owb_search_next(registry->bus, &state, &is_found);
+    }
+    if (status != OWB_STATUS_OK)
+    {
+        return status;
+    }
+
+    if (count == 0)
+    {
+        // empty bus (cable off?): keep the known devices for when it comes back
+        for (size_t i = 0; i < registry->count; ++i)
+        {
+            registry->entries[i].present = false;
+        }
+        registry->loaded = true;
+        registry->hotplug = false;
+        registry->bus_lost = true;
+        ESP_LOGW(TAG, "no devices found, keeping %u cached", (unsigned)registry->count);
+        return OWB_STATUS_OK;
+    }
+
+    // same set of devices (in search order, which is deterministic) => nothing to write
+    bool changed = (count != registry->count);
+    for (size_t i = 0; i < count && !changed; ++i)
+    {
+        changed = !_same_rom(&found[i].rom_code, &registry->entries[i].rom_code);
+    }
+
+    memcpy(registry->entries, found, count * sizeof(found[0]));
+    registry->count = count;
+    registry->loaded = true;
+    registry->hotplug = false;
+    registry->bus_lost = false;
+    ESP_LOGI(TAG, "enumerated %u devices%s", (unsigned)count, changed ? " (changed)" : "");
+
+    return changed ? owb_registry_save(registry) : OWB_STATUS_OK;
+}
+
+owb_status owb_registry_verify(owb_registry_t * registry, size_t * present)
+{
+    if (!registry)
+    {
+        return OWB_STATUS_PARAMETER_NULL;
+    }
+
+    size_t answered = 0;
+    owb_status status = OWB_STATUS_OK;
+    for (size_t i = 0; i < registry->count && status == OWB_STATUS_OK; ++i)
+    {
+        owb_registry_entry_t * entry = &registry->entries[i];
+        bool is_present = false;
+        status = registry->verify ? registry->verify(registry->bus, entry->rom_code, &is_present, registry->verify_ctx)
+                                  : owb_verify_rom(registry->bus, entry->rom_code, &is_present);
+        registry->verifications++;
+        entry->present = (status == OWB_STATUS_OK) && is_present;
+        if (entry->present)
+        {
+            answered++;
+        }
+        else
+        {
+            char rom_s[OWB_ROM_CODE_STRING_LENGTH];
+            owb_string_from_rom_code(entry->rom_code, rom_s, sizeof(rom_s));
+            ESP_LOGW(TAG, "cached device %s not responding", rom_s);
+        }
+    }
+
+    if (present)
+    {
+        *present = answered;
+    }
+    return status;
+}
+
+owb_status owb_registry_refresh(owb_registry_t * registry, size_t * present)
+{
+    if (!registry)
+    {
+        return OWB_STATUS_PARAMETER_NULL;
+    }
+
+    owb_status status = OWB_STATUS_OK;
+    if (!registry->loaded)
+    {
+        // a failed load just means a full enumeration below
+        owb_registry_load(registry);
+    }
+
+    bool enumerate = (registry->count == 0) || registry->hotplug;
+    size_t answered = 0;
+    if (!enumerate)
+    {
+        status = owb_registry_verify(registry, &answered);
+        if (status == OWB_STATUS_OK && answered == 0)
+        {
+            // nobody we know answers, but maybe somebody else does: replaced array
+            bool is_present = false;
+            owb_reset(registry->bus, &is_present);
+            enumerate = is_present;
+        }
+    }
+    if (enumerate)
+    {
+        status = owb_registry_enumerate(registry);
+        answered = (status == OWB_STATUS_OK) ? registry->count : 0;
+    }
+
+    if (present)
+    {
+        *present = answered;
+    }
+    return status;
+}
+
+void owb_registry_note_reset(owb_registry_t * registry, bool is_present)
+{
+    if (!registry)
+    {
+        return;
+    }
+    if (!is_present)
+    {
+        registry->bus_lost = true;
+    }
+    else if (registry->bus_lost)
+    {
+        // devices are back after an empty bus: they may not be the same ones
+        registry->bus_lost = false;
+        registry->hotplug = true;
+        registry->hotplug_hints++;
+        ESP_LOGI(TAG, "presence after an empty bus: re-enumeration pending");
+    }
+}
+
+bool owb_registry_hotplug_pending(const owb_registry_t * registry)
+{
+    return registry && registry->hotplug;
+}
+
+const owb_registry_entry_t * owb_registry_find(const owb_registry_t * registry, OneWireBus_ROMCode rom_code)
+{
+    if (!registry)
+    {
+        return NULL;
+    }
+    for (size_t i = 0; i < registry->count; ++i)
+    {
+        if (_same_rom(&registry->entries[i].rom_code, &rom_code))
+        {
+            return &registry->entries[i];
+        }
+    }
+    return NULL;
+}
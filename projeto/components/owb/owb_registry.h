@@ -0,0 +1,154 @@
+/**
+ * @file
+ * @brief Cache of the ROM codes found on a One Wire Bus.
+ *
+ * A full ROM search costs 64 triplets (two read slots and a write slot) per
+ * device, each slot a separate driver call, and nothing is remembered between
+ * boots. The registry keeps the devices found, optionally across reboots in NVS,
+ * so a known array is brought up with one verification per device instead of a
+ * full enumeration. Verification defaults to owb_verify_rom(); a device driver
+ * that has to talk to each device anyway can verify with that access instead
+ * (see owb_registry_set_verifier()), so confirming a known device costs no extra slots.
+ * A new enumeration only runs on a hot-plug hint: a reset that finds devices
+ * again after one that found none, or a bus where none of the cached devices
+ * answers any more.
+ */
+
+#pragma once
+#ifndef OWB_REGISTRY_H
+#define OWB_REGISTRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "owb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OWB_REGISTRY_MAX_DEVICES 16   ///< Devices remembered per bus
+
+/**
+ * @brief Presence check for one cached device, same contract as owb_verify_rom().
+ */
+typedef owb_status (*owb_registry_verify_fn)(const OneWireBus * bus, OneWireBus_ROMCode rom_code, bool * is_present, void * ctx);
+
+/**
+ * @brief One cached device.
+ */
+typedef struct
+{
+    OneWireBus_ROMCode rom_code;   ///< Device ROM code
+    bool present;                  ///< Answered the last verification or enumeration
+} owb_registry_entry_t;
+
+/**
+ * @brief Registry of the devices on one bus.
+ */
+typedef struct
+{
+    const OneWireBus * bus;                                ///< Bus the devices are on
+    const char * nvs_namespace;                            ///< NVS namespace for persistence, NULL for RAM only
+    owb_registry_entry_t entries[OWB_REGISTRY_MAX_DEVICES];
+    size_t count;                                          ///< Number of valid entries
+    owb_registry_verify_fn verify;                         ///< Presence check, NULL for owb_verify_rom()
+    void * verify_ctx;                                     ///< Passed to verify
+    bool loaded;                                           ///< NVS has been read (or there is no NVS)
+    bool bus_lost;                                         ///< Last reported reset found no device
+    bool hotplug;                                          ///< Re-enumeration pending
+    uint32_t enumerations;                                 ///< Full ROM searches run
+    uint32_t verifications;                                ///< Single-device verifications run
+    uint32_t hotplug_hints;                                ///< Hot-plug hints raised
+} owb_registry_t;
+
+/**
+ * @brief Initialise an empty registry. Does not touch the bus or NVS.
+ * @param[in] registry Registry to initialise.
+ * @param[in] bus Pointer to initialised bus instance.
+ * @param[in] nvs_namespace NVS namespace used to persist the ROM codes (nvs_flash_init()
+ *                          must have been called), or NULL to keep them in RAM only.
+ * @return status
+ */
+owb_status owb_registry_init(owb_registry_t * registry, const OneWireBus * bus, const char * nvs_namespace);
+
+/**
+ * @brief Replace the presence check used by owb_registry_verify().
+ * @param[in] registry Initialised registry.
+ * @param[in] verify Presence check, or NULL to go back to owb_verify_rom().
+ * @param[in] ctx Passed to verify.
+ */
+void owb_registry_set_verifier(owb_registry_t * registry, owb_registry_verify_fn verify, void * ctx);
+
+/**
+ * @brief Load the cached ROM codes from NVS. Nothing stored is not an error: the registry stays empty.
+ *        Entries whose CRC does not match are dropped.
+ * @param[in] registry Initialised registry.
+ * @return status, OWB_STATUS_HW_ERROR if NVS could not be read.
+ */
+owb_status owb_registry_load(owb_registry_t * registry);
+
+/**
+ * @brief Store the cached ROM codes in NVS. Does nothing without an NVS namespace.
+ * @param[in] registry Initialised registry.
+ * @return status, OWB_STATUS_HW_ERROR if NVS could not be written.
+ */
+owb_status owb_registry_save(owb_registry_t * registry);
+
+/**
+ * @brief Run a full ROM search and replace the cached devices with the ones found.
+ *        The result is saved to NVS if it differs from the cache. Clears any hot-plug hint.
+ * @param[in] registry Initialised registry.
+ * @return status
+ */
+owb_status owb_registry_enumerate(owb_registry_t * registry);
+
+/**
+ * @brief Verify each cached device (owb_verify_rom() unless another check was set)
+ *        and update its present flag.
+ * @param[in] registry Initialised registry.
+ * @param[out] present Number of cached devices that answered, may be NULL.
+ * @return status
+ */
+owb_status owb_registry_verify(owb_registry_t * registry, size_t * present);
+
+/**
+ * @brief Bring the registry up to date as cheaply as possible: load from NVS on
+ *        first use, then verify the cached devices. Enumerates instead if the cache
+ *        is empty, a hot-plug hint is pending, or no cached device answered
+ *        while the bus still shows a presence pulse.
+ * @param[in] registry Initialised registry.
+ * @param[out] present Number of devices marked present, may be NULL.
+ * @return status
+ */
+owb_status owb_registry_refresh(owb_registry_t * registry, size_t * present);
+
+/**
+ * @brief Report the outcome of a bus reset done elsewhere. A presence pulse after
+ *        a reset that found no device raises the hot-plug hint.
+ * @param[in] registry Initialised registry.
+ * @param[in] is_present Presence result of the reset.
+ */
+void owb_registry_note_reset(owb_registry_t * registry, bool is_present);
+
+/**
+ * @brief Check whether a re-enumeration is pending.
+ * @param[in] registry Initialised registry.
+ * @return true if owb_registry_refresh() or owb_registry_enumerate() should be run.
+ */
+bool owb_registry_hotplug_pending(const owb_registry_t * registry);
+
+/**
+ * @brief Look up a ROM code in the registry.
+ * @param[in] registry Initialised registry.
+ * @param[in] rom_code ROM code to find.
+ * @return Pointer to the entry, or NULL if the device is not cached.
+ */
+const owb_registry_entry_t * owb_registry_find(const owb_registry_t * registry, OneWireBus_ROMCode rom_code);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OWB_REGISTRY_H
@@ -56,215 +56,526 @@ sample code bearing this copyright.
 //--------------------------------------------------------------------------
 */
 
+#include <string.h>
+#include <stdlib.h>
+
 #include "owb.h"
 
-#include "driver/rmt.h"
-#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "driver/rmt_tx.h"
+#include "driver/rmt_rx.h"
+#include "driver/rmt_encoder.h"
+#include "esp_heap_caps.h"
+#include "esp_attr.h"
+#include "esp_check.h"
 #include "esp_log.h"
-#include "soc/gpio_periph.h"    // for GPIO_PIN_MUX_REG
+#include "soc/soc_caps.h"       // for SOC_RMT_MEM_WORDS_PER_CHANNEL
 
 #undef OW_DEBUG
 
 
-// bus reset: duration of low phase [us]
-#define OW_DURATION_RESET 480
+// 1 tick = 0.1us, fine enough for the 1us overdrive write-1 pulse
+#define OW_RMT_RESOLUTION_HZ 10000000
+#define OW_TICKS(us) ((uint16_t)((us) * 10))
 
-// overall slot duration
-#define OW_DURATION_SLOT 75
+/**
+ * @brief Slot timing for one bus speed, in RMT ticks (filter and idle in ns).
+ */
+typedef struct
+{
+    uint16_t reset;        ///< bus reset: duration of low phase
+    uint16_t presence;     ///< bus reset: presence detect window after releasing the bus
+    uint16_t slot;         ///< overall slot duration
+    uint16_t one_low;      ///< write 1 slot and read slot low phase
+    uint16_t zero_low;     ///< write 0 slot low phase
+    uint16_t sample;       ///< read slot: a low pulse shorter than this reads as 1
+    uint32_t filter_ns;    ///< RX glitch filter
+    uint32_t idle_ns;      ///< RX idle threshold: a capture ends once the line is stable for this long,
+                           ///< so it needs to be larger than any level inside a transaction (reset low, presence window)
+} owb_rmt_timing_t;
+
+static const owb_rmt_timing_t s_standard_timing = {
+    .reset = OW_TICKS(480),
+    .presence = OW_TICKS(480),
+    .slot = OW_TICKS(75),
+    .one_low = OW_TICKS(6),
+    .zero_low = OW_TICKS(65),
+    .sample = OW_TICKS(15 - 2),
+    .filter_ns = 1000,
+    .idle_ns = (480 + 120) * 1000,
+};
 
-// write 1 slot and read slot durations [us]
-#define OW_DURATION_1_LOW    6
-#define OW_DURATION_1_HIGH (OW_DURATION_SLOT - OW_DURATION_1_LOW)
+// overdrive: same shape, roughly ten times shorter (tRSTL >= 48us, tSLOT >= 6us, tRDV = 2us)
+static const owb_rmt_timing_t s_overdrive_timing = {
+    .reset = OW_TICKS(70),
+    .presence = OW_TICKS(70),
+    .slot = OW_TICKS(10),
+    .one_low = OW_TICKS(1),
+    .zero_low = OW_TICKS(8),
+    .sample = OW_TICKS(2),
+    .filter_ns = 300,
+    .idle_ns = (70 + 30) * 1000,
+};
 
-// write 0 slot durations [us]
-#define OW_DURATION_0_LOW   65
-#define OW_DURATION_0_HIGH (OW_DURATION_SLOT - OW_DURATION_0_LOW)
+// maximum number of bits that can be read or written per slot
+#define MAX_BITS_PER_SLOT (8)
 
-// sample time for read slot
-#define OW_DURATION_SAMPLE  (15-2)
+// symbols in a capture besides the slots: reset, presence and the final idle
+#define RX_EXTRA_SYMBOLS (4)
 
-// RX idle threshold
-// needs to be larger than any duration occurring during write slots
-#define OW_DURATION_RX_IDLE (OW_DURATION_SLOT + 2)
+// DMA capture buffer: slots per hardware transaction
+#define OW_DMA_MAX_SLOTS (64 * 8)
 
-// maximum number of bits that can be read or written per slot
-#define MAX_BITS_PER_SLOT (8)
+// number of 0xFF bytes available to encode read slots per transaction:
+// enough for a full DMA transaction, so reads are never split below it
+#define READ_SLOT_BYTES (OW_DMA_MAX_SLOTS / 8)
+
+// transmit/receive timeout
+#define OW_TIMEOUT_MS (100)
 
 static const char * TAG = "owb_rmt";
 
 #define info_of_driver(owb) container_of(owb, owb_rmt_driver_info, bus)
 
-// flush any pending/spurious traces from the RX channel
-static void onewire_flush_rmt_rx_buf(const OneWireBus * bus)
-{
-    void * p = NULL;
-    size_t s = 0;
+// read slots are write "1" slots sampled by the RX channel
+static const uint8_t s_read_slots[READ_SLOT_BYTES] = {
+    [0 ... READ_SLOT_BYTES - 1] = 0xFF,
+};
 
-    owb_rmt_driver_info * i = info_of_driver(bus);
+/**
+ * @brief One hardware transaction: optional reset, then write bytes, then read slots, then single bits.
+ *        Passed to rmt_transmit() as the primary data of the 1-Wire encoder.
+ */
+typedef struct
+{
+    bool reset;
+    const uint8_t * tx;
+    size_t tx_len;
+    size_t read_len;                      ///< bytes of read slots
+    const rmt_symbol_word_t * bits;       ///< pre-encoded single slots (bit-level access)
+    size_t bits_len;
+} owb_rmt_frame_t;
+
+/**
+ * @brief 1-Wire encoder, in the shape of led_strip_rmt_encoder.c: a copy encoder for
+ *        the reset pulse and single slots, a bytes encoder for the data bytes.
+ */
+typedef struct
+{
+    rmt_encoder_t base;
+    rmt_encoder_t * bytes_encoder;
+    rmt_encoder_t * copy_encoder;
+    int state;
+    rmt_symbol_word_t reset_code;
+} owb_rmt_encoder_t;
+
+enum
+{
+    ENC_STATE_RESET = 0,
+    ENC_STATE_TX,
+    ENC_STATE_READ,
+    ENC_STATE_BITS,
+};
 
-    while ((p = xRingbufferReceive(i->rb, &s, 0)))
+static size_t _encode(rmt_encoder_t * encoder, rmt_channel_handle_t channel, const void * primary_data,
+                      size_t data_size, rmt_encode_state_t * ret_state)
+{
+    owb_rmt_encoder_t * ow_encoder = __containerof(encoder, owb_rmt_encoder_t, base);
+    rmt_encoder_handle_t bytes_encoder = ow_encoder->bytes_encoder;
+    rmt_encoder_handle_t copy_encoder = ow_encoder->copy_encoder;
+    const owb_rmt_frame_t * frame = (const owb_rmt_frame_t *)primary_data;
+    rmt_encode_state_t session_state = 0;
+    rmt_encode_state_t state = 0;
+    size_t encoded_symbols = 0;
+
+    // as in led_strip_rmt_encoder.c: advance as soon as a part is complete, even if
+    // it filled the channel memory exactly, so the next call doesn't encode it again
+    switch (ow_encoder->state)
     {
-        ESP_LOGD(TAG, "flushing entry");
-        vRingbufferReturnItem(i->rb, p);
+    case ENC_STATE_RESET:
+        if (frame->reset)
+        {
+            encoded_symbols += copy_encoder->encode(copy_encoder, channel, &ow_encoder->reset_code,
+                                                    sizeof(ow_encoder->reset_code), &session_state);
+            if (session_state & RMT_ENCODING_COMPLETE)
+            {
+                ow_encoder->state = ENC_STATE_TX;
+            }
+            if (session_state & RMT_ENCODING_MEM_FULL)
+            {
+                state |= RMT_ENCODING_MEM_FULL;
+                goto out;  // yield if there's no free space for encoding artifacts
+            }
+        }
+        ow_encoder->state = ENC_STATE_TX;
+    // fall-through
+    case ENC_STATE_TX:
+        if (frame->tx_len)
+        {
+            encoded_symbols += bytes_encoder->encode(bytes_encoder, channel, frame->tx, frame->tx_len, &session_state);
+            if (session_state & RMT_ENCODING_COMPLETE)
+            {
+                ow_encoder->state = ENC_STATE_READ;
+            }
+            if (session_state & RMT_ENCODING_MEM_FULL)
+            {
+                state |= RMT_ENCODING_MEM_FULL;
+                goto out;
+            }
+        }
+        ow_encoder->state = ENC_STATE_READ;
+    // fall-through
+    case ENC_STATE_READ:
+        if (frame->read_len)
+        {
+            encoded_symbols += bytes_encoder->encode(bytes_encoder, channel, s_read_slots, frame->read_len, &session_state);
+            if (session_state & RMT_ENCODING_COMPLETE)
+            {
+                ow_encoder->state = ENC_STATE_BITS;
+            }
+            if (session_state & RMT_ENCODING_MEM_FULL)
+            {
+                state |= RMT_ENCODING_MEM_FULL;
+                goto out;
+            }
+        }
+        ow_encoder->state = ENC_STATE_BITS;
+    // fall-through
+    case ENC_STATE_BITS:
+        if (frame->bits_len)
+        {
+            encoded_symbols += copy_encoder->encode(copy_encoder, channel, frame->bits,
+                                                    frame->bits_len * sizeof(rmt_symbol_word_t), &session_state);
+            if (session_state & RMT_ENCODING_COMPLETE)
+            {
+                ow_encoder->state = ENC_STATE_RESET;  // back to the initial encoding session
+                state |= RMT_ENCODING_COMPLETE;
+            }
+            if (session_state & RMT_ENCODING_MEM_FULL)
+            {
+                state |= RMT_ENCODING_MEM_FULL;
+                goto out;
+            }
+        }
+        ow_encoder->state = ENC_STATE_RESET;
+        state |= RMT_ENCODING_COMPLETE;
     }
+out:
+    *ret_state = state;
+    return encoded_symbols;
 }
 
-static owb_status _reset(const OneWireBus * bus, bool * is_present)
+static esp_err_t _del_encoder(rmt_encoder_t * encoder)
 {
-    rmt_item32_t tx_items[1] = {0};
-    bool _is_present = false;
-    int res = OWB_STATUS_OK;
+    owb_rmt_encoder_t * ow_encoder = __containerof(encoder, owb_rmt_encoder_t, base);
+    rmt_del_encoder(ow_encoder->bytes_encoder);
+    rmt_del_encoder(ow_encoder->copy_encoder);
+    free(ow_encoder);
+    return ESP_OK;
+}
 
-    owb_rmt_driver_info * i = info_of_driver(bus);
+static esp_err_t _reset_encoder(rmt_encoder_t * encoder)
+{
+    owb_rmt_encoder_t * ow_encoder = __containerof(encoder, owb_rmt_encoder_t, base);
+    rmt_encoder_reset(ow_encoder->bytes_encoder);
+    rmt_encoder_reset(ow_encoder->copy_encoder);
+    ow_encoder->state = ENC_STATE_RESET;
+    return ESP_OK;
+}
 
-    tx_items[0].duration0 = OW_DURATION_RESET;
-    tx_items[0].level0 = 0;
-    tx_items[0].duration1 = 0;
-    tx_items[0].level1 = 1;
+static rmt_symbol_word_t _encode_write_slot(const owb_rmt_timing_t * timing, uint8_t val)
+{
+    uint16_t low = val ? timing->one_low : timing->zero_low;
+    rmt_symbol_word_t symbol = {
+        .level0 = 0,
+        .duration0 = low,
+        .level1 = 1,
+        .duration1 = timing->slot - low,
+    };
+    return symbol;
+}
 
-    uint16_t old_rx_thresh = 0;
-    rmt_get_rx_idle_thresh(i->rx_channel, &old_rx_thresh);
-    rmt_set_rx_idle_thresh(i->rx_channel, OW_DURATION_RESET + 60);
+static esp_err_t _new_encoder(const owb_rmt_timing_t * timing, rmt_encoder_handle_t * ret_encoder)
+{
+    esp_err_t ret = ESP_OK;
+    owb_rmt_encoder_t * ow_encoder = calloc(1, sizeof(owb_rmt_encoder_t));
+    ESP_GOTO_ON_FALSE(ow_encoder, ESP_ERR_NO_MEM, err, TAG, "no mem for 1-wire encoder");
+    ow_encoder->base.encode = _encode;
+    ow_encoder->base.del = _del_encoder;
+    ow_encoder->base.reset = _reset_encoder;
+
+    // 1-Wire is lsb first
+    rmt_bytes_encoder_config_t bytes_encoder_config = {
+        .bit0 = _encode_write_slot(timing, 0),
+        .bit1 = _encode_write_slot(timing, 1),
+        .flags.msb_first = 0,
+    };
+    ESP_GOTO_ON_ERROR(rmt_new_bytes_encoder(&bytes_encoder_config, &ow_encoder->bytes_encoder), err, TAG, "create bytes encoder failed");
+    rmt_copy_encoder_config_t copy_encoder_config = {};
+    ESP_GOTO_ON_ERROR(rmt_new_copy_encoder(&copy_encoder_config, &ow_encoder->copy_encoder), err, TAG, "create copy encoder failed");
+
+    // reset pulse followed by the presence detect window
+    ow_encoder->reset_code = (rmt_symbol_word_t) {
+        .level0 = 0,
+        .duration0 = timing->reset,
+        .level1 = 1,
+        .duration1 = timing->presence,
+    };
+    *ret_encoder = &ow_encoder->base;
+    return ESP_OK;
+err:
+    if (ow_encoder)
+    {
+        if (ow_encoder->bytes_encoder)
+        {
+            rmt_del_encoder(ow_encoder->bytes_encoder);
+        }
+        if (ow_encoder->copy_encoder)
+        {
+            rmt_del_encoder(ow_encoder->copy_encoder);
+        }
+        free(ow_encoder);
+    }
+    return ret;
+}
+
+static const owb_rmt_timing_t * _timing(const owb_rmt_driver_info * info)
+{
+    return info->overdrive ? &s_overdrive_timing : &s_standard_timing;
+}
 
-    onewire_flush_rmt_rx_buf(bus);
-    rmt_rx_start(i->rx_channel, true);
-    if (rmt_write_items(i->tx_channel, tx_items, 1, true) == ESP_OK)
+// capture finished: hand the event to the waiting task
+static bool IRAM_ATTR _rx_done(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t * edata, void * user_ctx)
+{
+    BaseType_t woken = pdFALSE;
+    owb_rmt_driver_info * info = (owb_rmt_driver_info *)user_ctx;
+    xQueueSendFromISR(info->rx_queue, edata, &woken);
+    return woken == pdTRUE;
+}
+
+/**
+ * @brief Count the low pulses in a capture: one per slot, plus reset and presence.
+ */
+static size_t _count_low_pulses(const rmt_symbol_word_t * symbols, size_t num_symbols)
+{
+    size_t lows = 0;
+    for (size_t i = 0; i < num_symbols; i++)
     {
-        size_t rx_size = 0;
-        rmt_item32_t * rx_items = (rmt_item32_t *)xRingbufferReceive(i->rb, &rx_size, 100 / portTICK_PERIOD_MS);
+        if (symbols[i].duration0 && symbols[i].level0 == 0)
+        {
+            lows++;
+        }
+        if (symbols[i].duration1 && symbols[i].level1 == 0)
+        {
+            lows++;
+        }
+    }
+    return lows;
+}
 
-        if (rx_items)
+/**
+ * @brief Decode `rx_bits` low pulses, starting at pulse `first_read`, as read slots, lsb first.
+ */
+static void _decode_read_slots(const owb_rmt_timing_t * timing, const rmt_symbol_word_t * symbols,
+                               size_t num_symbols, size_t first_read, uint8_t * rx, size_t rx_bits)
+{
+    size_t low = 0;
+    memset(rx, 0, (rx_bits + 7) / 8);
+    for (size_t i = 0; i < num_symbols; i++)
+    {
+        for (int half = 0; half < 2; half++)
         {
-            if (rx_size >= (1 * sizeof(rmt_item32_t)))
+            uint32_t level = half ? symbols[i].level1 : symbols[i].level0;
+            uint32_t duration = half ? symbols[i].duration1 : symbols[i].duration0;
+            if (duration == 0 || level != 0)
             {
-#ifdef OW_DEBUG
-                ESP_LOGI(TAG, "rx_size: %d", rx_size);
-
-                for (int i = 0; i < (rx_size / sizeof(rmt_item32_t)); i++)
-                {
-                    ESP_LOGI(TAG, "i: %d, level0: %d, duration %d", i, rx_items[i].level0, rx_items[i].duration0);
-                    ESP_LOGI(TAG, "i: %d, level1: %d, duration %d", i, rx_items[i].level1, rx_items[i].duration1);
-                }
-#endif
-
-                // parse signal and search for presence pulse
-                if ((rx_items[0].level0 == 0) && (rx_items[0].duration0 >= OW_DURATION_RESET - 2))
+                continue;
+            }
+            if (low >= first_read && low - first_read < rx_bits)
+            {
+                size_t bit = low - first_read;
+                if (duration < timing->sample)
                 {
-                    if ((rx_items[0].level1 == 1) && (rx_items[0].duration1 > 0))
-                    {
-                        if (rx_items[1].level0 == 0)
-                        {
-                            _is_present = true;
-                        }
-                    }
+                    // rising edge occured before the sample point -> bit 1
+                    rx[bit / 8] |= 1 << (bit % 8);
                 }
             }
-
-            vRingbufferReturnItem(i->rb, (void *)rx_items);
+            low++;
         }
-        else
+    }
+}
+
+/**
+ * @brief Run one frame as a single RMT transmission. The RX channel is armed
+ *        beforehand only if the frame needs sampling (presence or read slots).
+ * @param[out] is_present presence pulse seen after the reset, may be NULL
+ * @param[out] rx read slots, lsb first; `rx_bits` is the number of trailing slots to decode
+ */
+static owb_status _run_frame(owb_rmt_driver_info * info, const owb_rmt_frame_t * frame,
+                             bool * is_present, uint8_t * rx, size_t rx_bits)
+{
+    const owb_rmt_timing_t * timing = _timing(info);
+    size_t slots = (frame->tx_len + frame->read_len) * 8 + frame->bits_len;
+    bool capture = frame->reset || rx_bits > 0;
+    owb_status res = OWB_STATUS_OK;
+
+    if (capture)
+    {
+        rmt_receive_config_t rx_config = {
+            .signal_range_min_ns = timing->filter_ns,
+            .signal_range_max_ns = timing->idle_ns,
+        };
+        xQueueReset(info->rx_queue);
+        if (rmt_receive(info->rx_channel, info->rx_buffer, info->rx_buffer_symbols * sizeof(rmt_symbol_word_t), &rx_config) != ESP_OK)
         {
-            // time out occurred, this indicates an unconnected / misconfigured bus
-            ESP_LOGE(TAG, "rx_items == 0");
-            res = OWB_STATUS_HW_ERROR;
+            ESP_LOGE(TAG, "rmt_receive() failed");
+            return OWB_STATUS_HW_ERROR;
         }
     }
-    else
+
+    rmt_transmit_config_t tx_config = {
+        .loop_count = 0,
+        .flags.eot_level = 1,   // release the bus when done
+    };
+    rmt_encoder_handle_t encoder = info->overdrive ? info->overdrive_encoder : info->encoder;
+    if (rmt_transmit(info->tx_channel, encoder, frame, sizeof(*frame), &tx_config) != ESP_OK ||
+        rmt_tx_wait_all_done(info->tx_channel, OW_TIMEOUT_MS) != ESP_OK)
     {
-        // error in tx channel
         ESP_LOGE(TAG, "Error tx");
         res = OWB_STATUS_HW_ERROR;
     }
 
-    rmt_rx_stop(i->rx_channel);
-    rmt_set_rx_idle_thresh(i->rx_channel, old_rx_thresh);
+    if (!capture)
+    {
+        return res;
+    }
 
-    *is_present = _is_present;
+    // the capture completes once the bus has been idle for timing->idle_ns
+    rmt_rx_done_event_data_t event;
+    if (xQueueReceive(info->rx_queue, &event, pdMS_TO_TICKS(OW_TIMEOUT_MS)) != pdTRUE)
+    {
+        // time out occurred, this indicates an unconnected / misconfigured bus
+        ESP_LOGE(TAG, "rx timeout");
+        return OWB_STATUS_HW_ERROR;
+    }
+    if (res != OWB_STATUS_OK)
+    {
+        return res;
+    }
 
-    ESP_LOGD(TAG, "_is_present %d", _is_present);
+#ifdef OW_DEBUG
+    for (int i = 0; i < event.num_symbols; i++)
+    {
+        ESP_LOGI(TAG, "level: %d, duration %d", event.received_symbols[i].level0, event.received_symbols[i].duration0);
+        ESP_LOGI(TAG, "level: %d, duration %d", event.received_symbols[i].level1, event.received_symbols[i].duration1);
+    }
+#endif
 
+    // every slot is one low pulse; after a reset there is the reset pulse itself
+    // and, if anybody answered, the presence pulse
+    size_t lows = _count_low_pulses(event.received_symbols, event.num_symbols);
+    size_t expected = slots + (frame->reset ? 1 : 0);
+    bool present = frame->reset && lows == expected + 1;
+    if (lows != expected && !present)
+    {
+        ESP_LOGE(TAG, "unexpected capture: %d low pulses, %d expected", (int)lows, (int)expected);
+        res = OWB_STATUS_HW_ERROR;
+    }
+    else if (rx_bits)
+    {
+        _decode_read_slots(timing, event.received_symbols, event.num_symbols, lows - rx_bits, rx, rx_bits);
+    }
+
+    if (is_present)
+    {
+        *is_present = present;
+    }
     return res;
 }
 
-static rmt_item32_t _encode_write_slot(uint8_t val)
+/**
+ * @brief reset + write + read as one hardware transaction per capture buffer:
+ *        with DMA up to OW_DMA_MAX_SLOTS / 8 bytes (a whole scratchpad access) are
+ *        a single rmt_transmit; without it the sequence is split at byte
+ *        boundaries to fit the channel memory.
+ */
+static owb_status _transaction(const OneWireBus * bus, bool reset, const uint8_t * tx, size_t tx_len,
+                               uint8_t * rx, size_t rx_len, bool * is_present)
 {
-    rmt_item32_t item = {0};
+    owb_rmt_driver_info * info = info_of_driver(bus);
+    size_t max_bytes = (info->rx_buffer_symbols - RX_EXTRA_SYMBOLS) / 8;
+    if (max_bytes > READ_SLOT_BYTES)
+    {
+        max_bytes = READ_SLOT_BYTES;
+    }
+    size_t total = tx_len + rx_len;
+    size_t pos = 0;
+    owb_status res = OWB_STATUS_OK;
 
-    item.level0 = 0;
-    item.level1 = 1;
-    if (val)
+    if (is_present)
     {
-        // write "1" slot
-        item.duration0 = OW_DURATION_1_LOW;
-        item.duration1 = OW_DURATION_1_HIGH;
+        *is_present = false;
     }
-    else
+    if (!reset && total == 0)
     {
-        // write "0" slot
-        item.duration0 = OW_DURATION_0_LOW;
-        item.duration1 = OW_DURATION_0_HIGH;
+        return OWB_STATUS_OK;
     }
 
-    return item;
+    do
+    {
+        size_t n = total - pos < max_bytes ? total - pos : max_bytes;
+        size_t tx_n = pos < tx_len ? (tx_len - pos < n ? tx_len - pos : n) : 0;
+        owb_rmt_frame_t frame = {
+            .reset = reset && pos == 0,
+            .tx = tx ? tx + pos : NULL,
+            .tx_len = tx_n,
+            .read_len = n - tx_n,
+        };
+        uint8_t * rx_out = frame.read_len ? rx + (pos + tx_n - tx_len) : NULL;
+        res = _run_frame(info, &frame, frame.reset ? is_present : NULL, rx_out, frame.read_len * 8);
+        pos += n;
+    }
+    while (pos < total && res == OWB_STATUS_OK);
+
+    return res;
+}
+
+static owb_status _reset(const OneWireBus * bus, bool * is_present)
+{
+    owb_status res = _transaction(bus, true, NULL, 0, NULL, 0, is_present);
+    ESP_LOGD(TAG, "_is_present %d", *is_present);
+    return res;
 }
 
 /** NOTE: The data is shifted out of the low bits, eg. it is written in the order of lsb to msb */
 static owb_status _write_bits(const OneWireBus * bus, uint8_t out, int number_of_bits_to_write)
 {
-    rmt_item32_t tx_items[MAX_BITS_PER_SLOT + 1] = {0};
-    owb_rmt_driver_info * info = info_of_driver(bus);
+    rmt_symbol_word_t symbols[MAX_BITS_PER_SLOT];
 
     if (number_of_bits_to_write > MAX_BITS_PER_SLOT)
     {
         return OWB_STATUS_TOO_MANY_BITS;
     }
 
-    // write requested bits as pattern to TX buffer
+    const owb_rmt_timing_t * timing = _timing(info_of_driver(bus));
     for (int i = 0; i < number_of_bits_to_write; i++)
     {
-        tx_items[i] = _encode_write_slot(out & 0x01);
+        symbols[i] = _encode_write_slot(timing, out & 0x01);
         out >>= 1;
     }
 
-    // end marker
-    tx_items[number_of_bits_to_write].level0 = 1;
-    tx_items[number_of_bits_to_write].duration0 = 0;
-
-    owb_status status = OWB_STATUS_NOT_SET;
-
-    if (rmt_write_items(info->tx_channel, tx_items, number_of_bits_to_write+1, true) == ESP_OK)
-    {
-        status = OWB_STATUS_OK;
-    }
-    else
-    {
-        status = OWB_STATUS_HW_ERROR;
-        ESP_LOGE(TAG, "rmt_write_items() failed");
-    }
-
-    return status;
-}
-
-static rmt_item32_t _encode_read_slot(void)
-{
-    rmt_item32_t item = {0};
-
-    // construct pattern for a single read time slot
-    item.level0    = 0;
-    item.duration0 = OW_DURATION_1_LOW;   // shortly force 0
-    item.level1    = 1;
-    item.duration1 = OW_DURATION_1_HIGH;  // release high and finish slot
-    return item;
+    owb_rmt_frame_t frame = {
+        .bits = symbols,
+        .bits_len = number_of_bits_to_write,
+    };
+    return _run_frame(info_of_driver(bus), &frame, NULL, NULL, 0);
 }
 
 /** NOTE: Data is read into the high bits, eg. each bit read is shifted down before the next bit is read */
 static owb_status _read_bits(const OneWireBus * bus, uint8_t *in, int number_of_bits_to_read)
 {
-    rmt_item32_t tx_items[MAX_BITS_PER_SLOT + 1] = {0};
-    uint8_t read_data = 0;
-    int res = OWB_STATUS_OK;
-
-    owb_rmt_driver_info *info = info_of_driver(bus);
+    rmt_symbol_word_t symbols[MAX_BITS_PER_SLOT];
 
     if (number_of_bits_to_read > MAX_BITS_PER_SLOT)
     {
@@ -272,79 +583,89 @@ static owb_status _read_bits(const OneWireBus * bus, uint8_t *in, int number_of_
         return OWB_STATUS_TOO_MANY_BITS;
     }
 
-    // generate requested read slots
+    const owb_rmt_timing_t * timing = _timing(info_of_driver(bus));
     for (int i = 0; i < number_of_bits_to_read; i++)
     {
-        tx_items[i] = _encode_read_slot();
+        symbols[i] = _encode_write_slot(timing, 1);
     }
 
-    // end marker
-    tx_items[number_of_bits_to_read].level0 = 1;
-    tx_items[number_of_bits_to_read].duration0 = 0;
+    owb_rmt_frame_t frame = {
+        .bits = symbols,
+        .bits_len = number_of_bits_to_read,
+    };
+    uint8_t read_data = 0;
+    owb_status res = _run_frame(info_of_driver(bus), &frame, NULL, &read_data, number_of_bits_to_read);
 
-    onewire_flush_rmt_rx_buf(bus);
-    rmt_rx_start(info->rx_channel, true);
-    if (rmt_write_items(info->tx_channel, tx_items, number_of_bits_to_read+1, true) == ESP_OK)
-    {
-        size_t rx_size = 0;
-        rmt_item32_t *rx_items = (rmt_item32_t *)xRingbufferReceive(info->rb, &rx_size, 100 / portTICK_PERIOD_MS);
+    // lsb first in the low bits, as the legacy driver returned them
+    *in = read_data;
+    return res;
+}
 
-        if (rx_items)
-        {
-#ifdef OW_DEBUG
-            for (int i = 0; i < rx_size / 4; i++)
-            {
-                ESP_LOGI(TAG, "level: %d, duration %d", rx_items[i].level0, rx_items[i].duration0);
-                ESP_LOGI(TAG, "level: %d, duration %d", rx_items[i].level1, rx_items[i].duration1);
-            }
-#endif
+static owb_status _write_bytes(const OneWireBus * bus, const uint8_t * buffer, size_t len)
+{
+    return _transaction(bus, false, buffer, len, NULL, 0, NULL);
+}
 
-            if (rx_size >= number_of_bits_to_read * sizeof(rmt_item32_t))
-            {
-                for (int i = 0; i < number_of_bits_to_read; i++)
-                {
-                    read_data >>= 1;
-                    // parse signal and identify logical bit
-                    if (rx_items[i].level1 == 1)
-                    {
-                        if ((rx_items[i].level0 == 0) && (rx_items[i].duration0 < OW_DURATION_SAMPLE))
-                        {
-                            // rising edge occured before 15us -> bit 1
-                            read_data |= 0x80;
-                        }
-                    }
-                }
-                read_data >>= 8 - number_of_bits_to_read;
-            }
+static owb_status _read_bytes(const OneWireBus * bus, uint8_t * buffer, size_t len)
+{
+    return _transaction(bus, false, NULL, 0, buffer, len, NULL);
+}
 
-            vRingbufferReturnItem(info->rb, (void *)rx_items);
-        }
-        else
-        {
-            // time out occurred, this indicates an unconnected / misconfigured bus
-            ESP_LOGE(TAG, "rx_items == 0");
-            res = OWB_STATUS_HW_ERROR;
-        }
-    }
-    else
+static owb_status _bus_transaction(const OneWireBus * bus, const uint8_t * tx, size_t tx_len,
+                                   uint8_t * rx, size_t rx_len, bool * is_present)
+{
+    return _transaction(bus, true, tx, tx_len, rx, rx_len, is_present);
+}
+
+/**
+ * @brief Select the encoder and sampling thresholds for the requested speed.
+ *        Both encoders are built at init, so switching costs nothing on the bus.
+ */
+static owb_status _set_speed(const OneWireBus * bus, bool overdrive)
+{
+    owb_rmt_driver_info * info = info_of_driver(bus);
+    if (overdrive && !info->overdrive_encoder)
     {
-        // error in tx channel
-        ESP_LOGE(TAG, "Error tx");
-        res = OWB_STATUS_HW_ERROR;
+        return OWB_STATUS_NOT_SUPPORTED;
     }
-
-    rmt_rx_stop(info->rx_channel);
-
-    *in = read_data;
-    return res;
+    info->overdrive = overdrive;
+    return OWB_STATUS_OK;
 }
 
 static owb_status _uninitialize(const OneWireBus *bus)
 {
     owb_rmt_driver_info * info = info_of_driver(bus);
 
-    rmt_driver_uninstall(info->tx_channel);
-    rmt_driver_uninstall(info->rx_channel);
+    if (info->tx_channel)
+    {
+        rmt_disable(info->tx_channel);
+        rmt_del_channel(info->tx_channel);
+        info->tx_channel = NULL;
+    }
+    if (info->rx_channel)
+    {
+        rmt_disable(info->rx_channel);
+        rmt_del_channel(info->rx_channel);
+        info->rx_channel = NULL;
+    }
+    if (info->encoder)
+    {
+        rmt_del_encoder(info->encoder);
+        info->encoder = NULL;
+    }
+    if (info->overdrive_encoder)
+    {
+        rmt_del_encoder(info->overdrive_encoder);
+        info->overdrive_encoder = NULL;
+    }
+    info->overdrive = false;
+    if (info->rx_queue)
+    {
+        vQueueDelete(info->rx_queue);
+        info->rx_queue = NULL;
+    }
+    free(info->rx_buffer);
+    info->rx_buffer = NULL;
 
     return OWB_STATUS_OK;
 }
@@ -355,118 +676,95 @@ static struct owb_driver rmt_function_table =
     .uninitialize = _uninitialize,
     .reset = _reset,
     .write_bits = _write_bits,
-    .read_bits = _read_bits
+    .read_bits = _read_bits,
+    .write_bytes = _write_bytes,
+    .read_bytes = _read_bytes,
+    .transaction = _bus_transaction,
+    .set_speed = _set_speed
 };
 
-static owb_status _init(owb_rmt_driver_info *info, gpio_num_t gpio_num,
-                        rmt_channel_t tx_channel, rmt_channel_t rx_channel)
+static owb_status _init(owb_rmt_driver_info *info, gpio_num_t gpio_num, bool with_dma)
 {
-    owb_status status = OWB_STATUS_HW_ERROR;
-
-    // Ensure the RMT peripheral is not already running
-    // Note: if using RMT elsewhere, don't call this here, call it at the start of your program instead.
-    //periph_module_disable(PERIPH_RMT_MODULE);
-    //periph_module_enable(PERIPH_RMT_MODULE);
-
+    memset(info, 0, sizeof(*info));
     info->bus.driver = &rmt_function_table;
-    info->tx_channel = tx_channel;
-    info->rx_channel = rx_channel;
     info->gpio = gpio_num;
 
-#ifdef OW_DEBUG
-    ESP_LOGI(TAG, "RMT TX channel: %d", info->tx_channel);
-    ESP_LOGI(TAG, "RMT RX channel: %d", info->rx_channel);
-#endif
-
-    rmt_config_t rmt_tx = {0};
-    rmt_tx.channel = info->tx_channel;
-    rmt_tx.gpio_num = gpio_num;
-    rmt_tx.mem_block_num = 1;
-    rmt_tx.clk_div = 80;
-    rmt_tx.tx_config.loop_en = false;
-    rmt_tx.tx_config.carrier_en = false;
-    rmt_tx.tx_config.idle_level = 1;
-    rmt_tx.tx_config.idle_output_en = true;
-    rmt_tx.rmt_mode = RMT_MODE_TX;
-    if (rmt_config(&rmt_tx) == ESP_OK)
-    {
-        if (rmt_driver_install(rmt_tx.channel, 0, ESP_INTR_FLAG_LOWMED | ESP_INTR_FLAG_IRAM | ESP_INTR_FLAG_SHARED) == ESP_OK)
-        {
-            rmt_set_source_clk(rmt_tx.channel, RMT_BASECLK_APB);  // only APB is supported by IDF 4.2
-            rmt_config_t rmt_rx = {0};
-            rmt_rx.channel = info->rx_channel;
-            rmt_rx.gpio_num = gpio_num;
-            rmt_rx.clk_div = 80;
-            rmt_rx.mem_block_num = 1;
-            rmt_rx.rmt_mode = RMT_MODE_RX;
-            rmt_rx.rx_config.filter_en = true;
-            rmt_rx.rx_config.filter_ticks_thresh = 30;
-            rmt_rx.rx_config.idle_threshold = OW_DURATION_RX_IDLE;
-            if (rmt_config(&rmt_rx) == ESP_OK)
-            {
-                if (rmt_driver_install(rmt_rx.channel, 512, ESP_INTR_FLAG_LOWMED | ESP_INTR_FLAG_IRAM | ESP_INTR_FLAG_SHARED) == ESP_OK)
-                {
-                    rmt_set_source_clk(rmt_rx.channel, RMT_BASECLK_APB);  // only APB is supported by IDF 4.2
-                    rmt_get_ringbuf_handle(info->rx_channel, &info->rb);
-                    status = OWB_STATUS_OK;
-                }
-                else
-                {
-                    ESP_LOGE(TAG, "failed to install rx driver");
-                }
-            }
-            else
-            {
-                status = OWB_STATUS_HW_ERROR;
-                ESP_LOGE(TAG, "failed to configure rx, uninstalling rmt driver on tx channel");
-                rmt_driver_uninstall(rmt_tx.channel);
-            }
-        }
-        else
-        {
-            ESP_LOGE(TAG, "failed to install tx driver");
-        }
-    }
-    else
+    // without DMA a capture has to fit the channel memory; with DMA it lands
+    // straight in a (DMA-capable) buffer and a whole transaction fits. TX uses
+    // DMA as well, so the slots of a long transaction are not refilled from the
+    // ISR while the bus is running.
+    size_t dma_symbols = OW_DMA_MAX_SLOTS + RX_EXTRA_SYMBOLS;
+    info->rx_buffer_symbols = with_dma ? dma_symbols : SOC_RMT_MEM_WORDS_PER_CHANNEL;
+    info->rx_buffer = heap_caps_calloc(info->rx_buffer_symbols, sizeof(rmt_symbol_word_t),
+                                       MALLOC_CAP_INTERNAL | (with_dma ? MALLOC_CAP_DMA : 0));
+    info->rx_queue = xQueueCreate(1, sizeof(rmt_rx_done_event_data_t));
+    if (!info->rx_buffer || !info->rx_queue)
     {
-        ESP_LOGE(TAG, "failed to configure tx");
+        ESP_LOGE(TAG, "no mem for rx buffer");
+        return OWB_STATUS_HW_ERROR;
     }
 
-    // attach GPIO to previous pin
-    if (gpio_num < 32)
+    // RX first: the TX channel then joins the same pin in open-drain loop-back mode
+    rmt_rx_channel_config_t rx_channel_config = {
+        .gpio_num = gpio_num,
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = OW_RMT_RESOLUTION_HZ,
+        .mem_block_symbols = info->rx_buffer_symbols,
+        .flags.with_dma = with_dma,
+    };
+    if (rmt_new_rx_channel(&rx_channel_config, &info->rx_channel) != ESP_OK)
     {
-        GPIO.enable_w1ts = (0x1 << gpio_num);
+        ESP_LOGE(TAG, "failed to create rx channel");
+        return OWB_STATUS_HW_ERROR;
     }
-    else
+
+    rmt_tx_channel_config_t tx_channel_config = {
+        .gpio_num = gpio_num,
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = OW_RMT_RESOLUTION_HZ,
+        .mem_block_symbols = with_dma ? dma_symbols : SOC_RMT_MEM_WORDS_PER_CHANNEL,
+        .trans_queue_depth = 4,
+        .flags.with_dma = with_dma,
+        .flags.io_loop_back = true,   // coexist with the rx channel on the same pin
+        .flags.io_od_mode = true,     // open drain: devices can pull the line low
+    };
+    if (rmt_new_tx_channel(&tx_channel_config, &info->tx_channel) != ESP_OK)
     {
-        GPIO.enable1_w1ts.data = (0x1 << (gpio_num - 32));
+        ESP_LOGE(TAG, "failed to create tx channel");
+        return OWB_STATUS_HW_ERROR;
     }
 
-    // attach RMT channels to new gpio pin
-    // ATTENTION: set pin for rx first since gpio_output_disable() will
-    //            remove rmt output signal in matrix!
-    rmt_set_gpio(info->rx_channel, RMT_MODE_RX, gpio_num, 0);
-    rmt_set_gpio(info->tx_channel, RMT_MODE_TX, gpio_num, 0);
-
-    // force pin direction to input to enable path to RX channel
-    PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[gpio_num]);
+    rmt_rx_event_callbacks_t callbacks = {
+        .on_recv_done = _rx_done,
+    };
+    if (rmt_rx_register_event_callbacks(info->rx_channel, &callbacks, info) != ESP_OK ||
+        _new_encoder(&s_standard_timing, &info->encoder) != ESP_OK ||
+        rmt_enable(info->rx_channel) != ESP_OK ||
+        rmt_enable(info->tx_channel) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "failed to set up rmt channels");
+        return OWB_STATUS_HW_ERROR;
+    }
 
-    // enable open drain
-    GPIO.pin[gpio_num].pad_driver = 1;
+    // the bus still works at standard speed without it
+    if (_new_encoder(&s_overdrive_timing, &info->overdrive_encoder) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "no overdrive encoder, standard speed only");
+        info->overdrive_encoder = NULL;
+    }
 
-    return status;
+    return OWB_STATUS_OK;
 }
 
-OneWireBus * owb_rmt_initialize(owb_rmt_driver_info * info, gpio_num_t gpio_num,
-                                rmt_channel_t tx_channel, rmt_channel_t rx_channel)
+OneWireBus * owb_rmt_initialize(owb_rmt_driver_info * info, gpio_num_t gpio_num, bool with_dma)
 {
-    ESP_LOGD(TAG, "%s: gpio_num: %d, tx_channel: %d, rx_channel: %d",
-             __func__, gpio_num, tx_channel, rx_channel);
+    ESP_LOGD(TAG, "%s: gpio_num: %d, with_dma: %d", __func__, gpio_num, with_dma);
 
-    owb_status status = _init(info, gpio_num, tx_channel, rx_channel);
+    owb_status status = _init(info, gpio_num, with_dma);
     if (status != OWB_STATUS_OK)
     {
         ESP_LOGE(TAG, "_init() failed with status %d", status);
+        _uninitialize(&info->bus);
     }
 
     info->bus.strong_pullup_gpio = GPIO_NUM_NC;
@@ -28,6 +28,8 @@
  * @brief Interface definitions for ESP32 RMT driver used to communicate with devices
  *        on the One Wire Bus.
  *
+ * Built on the rmt_tx/rmt_rx channel API (ESP-IDF v5).
+ *
  * This is the recommended driver.
  */
 
@@ -37,8 +39,8 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
-#include "freertos/ringbuf.h"
-#include "driver/rmt.h"
+#include "driver/rmt_tx.h"
+#include "driver/rmt_rx.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -49,24 +51,36 @@ extern "C" {
  */
 typedef struct
 {
-  int tx_channel;     ///< RMT channel to use for TX
-  int rx_channel;     ///< RMT channel to use for RX
-  RingbufHandle_t rb; ///< Ring buffer handle
-  int gpio;           ///< OneWireBus GPIO
-  OneWireBus bus;     ///< OneWireBus instance
+  rmt_channel_handle_t tx_channel;   ///< RMT TX channel, open drain with loop-back onto the RX pin
+  rmt_channel_handle_t rx_channel;   ///< RMT RX channel
+  rmt_encoder_handle_t encoder;      ///< 1-Wire encoder (reset pulse, bytes and single slots), standard speed
+  rmt_encoder_handle_t overdrive_encoder;  ///< Same encoder with overdrive timing, NULL if unavailable
+  bool overdrive;                    ///< Overdrive timing currently selected
+  rmt_symbol_word_t * rx_buffer;     ///< Capture buffer (DMA-capable when DMA is used)
+  size_t rx_buffer_symbols;          ///< Capture buffer size in symbols
+  QueueHandle_t rx_queue;            ///< Receives the capture-done event from the RX callback
+  int gpio;                          ///< OneWireBus GPIO
+  OneWireBus bus;                    ///< OneWireBus instance
 } owb_rmt_driver_info;
 
 /**
  * @brief Initialise the RMT driver.
+ *
+ * Each bus access (reset + ROM/function command + data) is encoded into a single
+ * RMT transmission and sampled by one RX capture, so no bit timing runs on the CPU.
+ * Without DMA a capture is limited to the RX channel memory and longer accesses
+ * are split at byte boundaries. With DMA both channels use DMA buffers and up to
+ * 64 bytes (written plus read) go out as one transmission; longer accesses are
+ * split the same way.
+ *
  * @param[in] info Pointer to an uninitialized owb_rmt_driver_info structure.
  *                 Note: the structure must remain in scope for the lifetime of this component.
  * @param[in] gpio_num The GPIO number to use as the One Wire bus data line.
- * @param[in] tx_channel The RMT channel to use for transmitting data to bus devices.
- * @param[in] rx_channel the RMT channel to use for receiving data from bus devices.
+ * @param[in] with_dma Transmit and capture through DMA, so a transaction of up to 64 bytes
+ *                     is one transmission and one capture.
  * @return OneWireBus *, pass this into the other OneWireBus public API functions
  */
-OneWireBus* owb_rmt_initialize(owb_rmt_driver_info * info, gpio_num_t gpio_num,
-                               rmt_channel_t tx_channel, rmt_channel_t rx_channel);
+OneWireBus* owb_rmt_initialize(owb_rmt_driver_info * info, gpio_num_t gpio_num, bool with_dma);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,283 @@
+/**
+ * @file
+ * @brief UART driver for the One Wire Bus: the UART generates the time slots,
+ *        so no bit timing runs on the CPU and interrupts stay enabled.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "driver/uart.h"
+#include "driver/gpio.h"
+#include "esp_log.h"
+
+#include "owb.h"
+#include "owb_uart.h"
+
+static const char * TAG = "owb_uart";
+
+// reset: 0xF0 at 9600 baud = start bit + 4 zero bits = 520us low, presence
+// pulses pull the upper bits low so the echo differs from 0xF0
+#define OW_UART_RESET_BAUD 9600
+#define OW_UART_RESET_CHAR 0xF0
+
+// slots: one character at 115200 baud = 87us; 0x00 keeps the line low for
+// 78us (write 0), 0xFF only for the 8.7us start bit (write 1 / read slot)
+#define OW_UART_SLOT_BAUD 115200
+#define OW_UART_SLOT_0 0x00
+#define OW_UART_SLOT_1 0xFF
+
+// overdrive: reset 0xE0 at 115200 baud = start bit + 5 zero bits = 52us low
+// (tRSTL >= 48us); slots at 1 Mbaud = 10us, write 1 low for 1us. Write 0 is
+// 0x80, low for 8us: with 0x00 only the 1us stop bit would separate it from the
+// next character, below the 2.5us overdrive recovery
+#define OW_UART_OD_RESET_BAUD 115200
+#define OW_UART_OD_RESET_CHAR 0xE0
+#define OW_UART_OD_SLOT_BAUD 1000000
+#define OW_UART_OD_SLOT_0 0x80
+
+// bytes per FIFO round trip (8 slot characters each, fits the 128-byte FIFO)
+#define OW_UART_CHUNK_BYTES 16
+
+#define OW_UART_RX_BUFFER (2 * SOC_UART_FIFO_LEN)
+
+// per-transfer timeout: the characters themselves plus scheduling margin
+#define OW_UART_TIMEOUT_MS(chars, baud) ((chars) * 10 * 1000 / (baud) + 10)
+
+#define MAX_BITS_PER_SLOT (8)
+
+#define info_of_driver(owb) container_of(owb, owb_uart_driver_info, bus)
+
+static owb_status _set_baud(owb_uart_driver_info * info, uint32_t baud)
+{
+    if (info->baud != baud)
+    {
+        // the previous characters must be out before the rate changes
+        uart_wait_tx_done(info->uart_num, pdMS_TO_TICKS(OW_UART_TIMEOUT_MS(SOC_UART_FIFO_LEN, info->baud)));
+        if (uart_set_baudrate(info->uart_num, baud) != ESP_OK)
+        {
+            return OWB_STATUS_HW_ERROR;
+        }
+        info->baud = baud;
+    }
+    return OWB_STATUS_OK;
+}
+
+/**
+ * @brief Send characters and collect their echo (TX and RX share the bus line,
+ *        so every character sent is also received, as modified by the devices).
+ */
+static owb_status _exchange(owb_uart_driver_info * info, const uint8_t * tx, uint8_t * rx, size_t len)
+{
+    uart_flush_input(info->uart_num);
+    if (uart_write_bytes(info->uart_num, tx, len) != (int)len)
+    {
+        ESP_LOGE(TAG, "uart_write_bytes() failed");
+        return OWB_STATUS_HW_ERROR;
+    }
+
+    int received = uart_read_bytes(info->uart_num, rx, len, pdMS_TO_TICKS(OW_UART_TIMEOUT_MS(len, info->baud)));
+    if (received != (int)len)
+    {
+        // no echo: bus not connected to RX, or shorted low
+        ESP_LOGE(TAG, "echo timeout: %d of %d characters", received, (int)len);
+        return OWB_STATUS_HW_ERROR;
+    }
+    return OWB_STATUS_OK;
+}
+
+static owb_status _reset(const OneWireBus * bus, bool * is_present)
+{
+    owb_uart_driver_info * info = info_of_driver(bus);
+    uint8_t tx = info->overdrive ? OW_UART_OD_RESET_CHAR : OW_UART_RESET_CHAR;
+    uint8_t rx = 0;
+
+    *is_present = false;
+    owb_status status = _set_baud(info, info->overdrive ? OW_UART_OD_RESET_BAUD : OW_UART_RESET_BAUD);
+    if (status == OWB_STATUS_OK)
+    {
+        status = _exchange(info, &tx, &rx, 1);
+    }
+    if (status == OWB_STATUS_OK)
+    {
+        *is_present = (rx != tx);
+    }
+    // back to slot rate, ready for the ROM command
+    _set_baud(info, info->overdrive ? OW_UART_OD_SLOT_BAUD : OW_UART_SLOT_BAUD);
+
+    ESP_LOGD(TAG, "reset echo 0x%02x, present %d", rx, *is_present);
+    return status;
+}
+
+// one slot character per bit, lsb first
+static void _encode_slots(const owb_uart_driver_info * info, const uint8_t * data, size_t bits, uint8_t * slots)
+{
+    uint8_t slot_0 = info->overdrive ? OW_UART_OD_SLOT_0 : OW_UART_SLOT_0;
+    for (size_t i = 0; i < bits; i++)
+    {
+        slots[i] = (data[i / 8] >> (i % 8)) & 0x01 ? OW_UART_SLOT_1 : slot_0;
+    }
+}
+
+// a slot reads 1 only if nobody pulled the line low after the start bit
+static void _decode_slots(const uint8_t * slots, size_t bits, uint8_t * data)
+{
+    memset(data, 0, (bits + 7) / 8);
+    for (size_t i = 0; i < bits; i++)
+    {
+        if (slots[i] == OW_UART_SLOT_1)
+        {
+            data[i / 8] |= 1 << (i % 8);
+        }
+    }
+}
+
+/**
+ * @brief Run `bits` slots: written from `out` (NULL for read slots), sampled into `in` (may be NULL).
+ */
+static owb_status _slots(owb_uart_driver_info * info, const uint8_t * out, uint8_t * in, size_t bits)
+{
+    uint8_t tx[OW_UART_CHUNK_BYTES * 8];
+    uint8_t rx[OW_UART_CHUNK_BYTES * 8];
+    owb_status status = OWB_STATUS_OK;
+
+    while (bits > 0 && status == OWB_STATUS_OK)
+    {
+        size_t n = bits < sizeof(tx) ? bits : sizeof(tx);
+        if (out)
+        {
+            _encode_slots(info, out, n, tx);
+            out += n / 8;
+        }
+        else
+        {
+            memset(tx, OW_UART_SLOT_1, n);
+        }
+
+        status = _exchange(info, tx, rx, n);
+        if (status == OWB_STATUS_OK && in)
+        {
+            _decode_slots(rx, n, in);
+            in += n / 8;
+        }
+        bits -= n;
+    }
+
+    return status;
+}
+
+/** NOTE: The data is shifted out of the low bits, eg. it is written in the order of lsb to msb */
+static owb_status _write_bits(const OneWireBus * bus, uint8_t out, int number_of_bits_to_write)
+{
+    if (number_of_bits_to_write > MAX_BITS_PER_SLOT)
+    {
+        return OWB_STATUS_TOO_MANY_BITS;
+    }
+    return _slots(info_of_driver(bus), &out, NULL, number_of_bits_to_write);
+}
+
+/** NOTE: Data is read into the high bits, eg. each bit read is shifted down before the next bit is read */
+static owb_status _read_bits(const OneWireBus * bus, uint8_t * in, int number_of_bits_to_read)
+{
+    uint8_t value = 0;
+
+    if (number_of_bits_to_read > MAX_BITS_PER_SLOT)
+    {
+        return OWB_STATUS_TOO_MANY_BITS;
+    }
+    owb_status status = _slots(info_of_driver(bus), NULL, &value, number_of_bits_to_read);
+    *in = value;
+    return status;
+}
+
+static owb_status _write_bytes(const OneWireBus * bus, const uint8_t * buffer, size_t len)
+{
+    return _slots(info_of_driver(bus), buffer, NULL, len * 8);
+}
+
+static owb_status _read_bytes(const OneWireBus * bus, uint8_t * buffer, size_t len)
+{
+    return _slots(info_of_driver(bus), NULL, buffer, len * 8);
+}
+
+// only the character rates change; the next reset or slot picks them up
+static owb_status _set_speed(const OneWireBus * bus, bool overdrive)
+{
+    owb_uart_driver_info * info = info_of_driver(bus);
+    info->overdrive = overdrive;
+    return _set_baud(info, overdrive ? OW_UART_OD_SLOT_BAUD : OW_UART_SLOT_BAUD);
+}
+
+static owb_status _uninitialize(const OneWireBus * bus)
+{
+    owb_uart_driver_info * info = info_of_driver(bus);
+    uart_driver_delete(info->uart_num);
+    return OWB_STATUS_OK;
+}
+
+static const struct owb_driver uart_function_table =
+{
+    .name = "owb_uart",
+    .uninitialize = _uninitialize,
+    .reset = _reset,
+    .write_bits = _write_bits,
+    .read_bits = _read_bits,
+    .write_bytes = _write_bytes,
+    .read_bytes = _read_bytes,
+    .set_speed = _set_speed
+};
+
+static owb_status _init(owb_uart_driver_info * info, uart_port_t uart_num, gpio_num_t gpio_num)
+{
+    const uart_config_t uart_config = {
+        .baud_rate = OW_UART_SLOT_BAUD,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+
+    // no TX ring buffer: uart_write_bytes fills the FIFO directly and the
+    // task sleeps until there is room
+    if (uart_driver_install(uart_num, OW_UART_RX_BUFFER, 0, 0, NULL, 0) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "failed to install uart driver");
+        return OWB_STATUS_HW_ERROR;
+    }
+    if (uart_param_config(uart_num, &uart_config) != ESP_OK ||
+        uart_set_pin(uart_num, gpio_num, gpio_num, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "failed to configure uart");
+        uart_driver_delete(uart_num);
+        return OWB_STATUS_HW_ERROR;
+    }
+
+    // TX and RX on the same pin: open drain, so devices can pull the line low
+    gpio_set_direction(gpio_num, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_pull_mode(gpio_num, GPIO_PULLUP_ONLY);
+
+    info->baud = OW_UART_SLOT_BAUD;
+    info->overdrive = false;
+    return OWB_STATUS_OK;
+}
+
+OneWireBus * owb_uart_initialize(owb_uart_driver_info * info, uart_port_t uart_num, gpio_num_t gpio_num)
+{
+    ESP_LOGD(TAG, "%s: uart_num: %d, gpio_num: %d", __func__, uart_num, gpio_num);
+
+    info->uart_num = uart_num;
+    info->gpio = gpio_num;
+    info->bus.driver = &uart_function_table;
+    info->bus.strong_pullup_gpio = GPIO_NUM_NC;
+
+    owb_status status = _init(info, uart_num, gpio_num);
+    if (status != OWB_STATUS_OK)
+    {
+        ESP_LOGE(TAG, "_init() failed with status %d", status);
+    }
+
+    return &(info->bus);
+}
@@ -0,0 +1,49 @@
+/**
+ * @file
+ * @brief Interface definitions for the ESP32 UART driver used to communicate with devices
+ *        on the One Wire Bus.
+ *
+ * TX and RX of one UART share the bus pin (open drain). A reset is a 0xF0 character
+ * at 9600 baud; each time slot is one character at 115200 baud (0xFF: write 1 / read,
+ * 0x00: write 0). The UART shifts the slots out of its FIFO while the CPU is free,
+ * and no section with interrupts disabled is needed.
+ */
+
+#pragma once
+#ifndef OWB_UART_H
+#define OWB_UART_H
+
+#include "owb.h"
+#include "driver/uart.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief UART driver information
+ */
+typedef struct
+{
+    uart_port_t uart_num;   ///< UART used for the bus (not shared with anything else)
+    int gpio;               ///< Value of the GPIO connected to the 1-Wire bus
+    uint32_t baud;          ///< Baud rate currently set (reset or slot rate)
+    bool overdrive;         ///< Overdrive reset character and rates selected
+    OneWireBus bus;         ///< OneWireBus instance
+} owb_uart_driver_info;
+
+/**
+ * @brief Initialise the UART driver.
+ * @param[in] info Pointer to an uninitialized owb_uart_driver_info structure.
+ *                 Note: the structure must remain in scope for the lifetime of this component.
+ * @param[in] uart_num UART port to use; its driver is installed here.
+ * @param[in] gpio_num The GPIO number to use as the One Wire bus data line.
+ * @return OneWireBus *, pass this into the other OneWireBus public API functions
+ */
+OneWireBus * owb_uart_initialize(owb_uart_driver_info * info, uart_port_t uart_num, gpio_num_t gpio_num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OWB_UART_H
@@ -0,0 +1,120 @@
+/*
+ * font5x7.h
+ *
+ * Fonte compacta 5x7 (domínio público, a clássica das bibliotecas de LCD),
+ * já organizada em colunas: cada byte é uma coluna, bit 0 = linha de cima,
+ * igual ao mapeamento de páginas da GDDRAM do SSD1306.
+ *
+ * Cobre U+0020 - U+007E. A posição U+007F (DEL) foi trocada pelo símbolo de
+ * grau, para escrever "25.0\x7F" + "C".
+ */
+
+#ifndef FONT5X7_H_
+#define FONT5X7_H_
+
+#include <stdint.h>
+
+#define FONT5X7_FIRST_CHAR 0x20
+#define FONT5X7_LAST_CHAR  0x7F
+#define FONT5X7_DEGREE     0x7F
+
+static const uint8_t font5x7[FONT5X7_LAST_CHAR - FONT5X7_FIRST_CHAR + 1][5] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0020 (space)
+    { 0x00, 0x00, 0x5F, 0x00, 0x00 },   // U+0021 (!)
+    { 0x00, 0x07, 0x00, 0x07, 0x00 },   // U+0022 (")
+    { 0x14, 0x7F, 0x14, 0x7F, 0x14 },   // U+0023 (#)
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 },   // U+0024 ($)
+    { 0x23, 0x13, 0x08, 0x64, 0x62 },   // U+0025 (%)
+    { 0x36, 0x49, 0x55, 0x22, 0x50 },   // U+0026 (&)
+    { 0x00, 0x05, 0x03, 0x00, 0x00 },   // U+0027 (')
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 },   // U+0028 (()
+    { 0x00, 0x41, 0x22, 0x1C, 0x00 },   // U+0029 ())
+    { 0x08, 0x2A, 0x1C, 0x2A, 0x08 },   // U+002A (*)
+    { 0x08, 0x08, 0x3E, 0x08, 0x08 },   // U+002B (+)
+    { 0x00, 0x50, 0x30, 0x00, 0x00 },   // U+002C (,)
+    { 0x08, 0x08, 0x08, 0x08, 0x08 },   // U+002D (-)
+    { 0x00, 0x60, 0x60, 0x00, 0x00 },   // U+002E (.)
+    { 0x20, 0x10, 0x08, 0x04, 0x02 },   // U+002F (/)
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E },   // U+0030 (0)
+    { 0x00, 0x42, 0x7F, 0x40, 0x00 },   // U+0031 (1)
+    { 0x42, 0x61, 0x51, 0x49, 0x46 },   // U+0032 (2)
+    { 0x21, 0x41, 0x45, 0x4B, 0x31 },   // U+0033 (3)
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 },   // U+0034 (4)
+    { 0x27, 0x45, 0x45, 0x45, 0x39 },   // U+0035 (5)
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 },   // U+0036 (6)
+    { 0x01, 0x71, 0x09, 0x05, 0x03 },   // U+0037 (7)
+    { 0x36, 0x49, 0x49, 0x49, 0x36 },   // U+0038 (8)
+    { 0x06, 0x49, 0x49, 0x29, 0x1E },   // U+0039 (9)
+    { 0x00, 0x36, 0x36, 0x00, 0x00 },   // U+003A (:)
+    { 0x00, 0x56, 0x36, 0x00, 0x00 },   // U+003B (;)
+    { 0x08, 0x14, 0x22, 0x41, 0x00 },   // U+003C (<)
+    { 0x14, 0x14, 0x14, 0x14, 0x14 },   // U+003D (=)
+    { 0x00, 0x41, 0x22, 0x14, 0x08 },   // U+003E (>)
+    { 0x02, 0x01, 0x51, 0x09, 0x06 },   // U+003F (?)
+    { 0x32, 0x49, 0x79, 0x41, 0x3E },   // U+0040 (@)
+    { 0x7E, 0x11, 0x11, 0x11, 0x7E },   // U+0041 (A)
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 },   // U+0042 (B)
+    { 0x3E, 0x41, 0x41, 0x41, 0x22 },   // U+0043 (C)
+    { 0x7F, 0x41, 0x41, 0x22, 0x1C },   // U+0044 (D)
+    { 0x7F, 0x49, 0x49, 0x49, 0x41 },   // U+0045 (E)
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 },   // U+0046 (F)
+    { 0x3E, 0x41, 0x49, 0x49, 0x7A },   // U+0047 (G)
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F },   // U+0048 (H)
+    { 0x00, 0x41, 0x7F, 0x41, 0x00 },   // U+0049 (I)
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 },   // U+004A (J)
+    { 0x7F, 0x08, 0x14, 0x22, 0x41 },   // U+004B (K)
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 },   // U+004C (L)
+    { 0x7F, 0x02, 0x0C, 0x02, 0x7F },   // U+004D (M)
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F },   // U+004E (N)
+    { 0x3E, 0x41, 0x41, 0x41, 0x3E },   // U+004F (O)
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 },   // U+0050 (P)
+    { 0x3E, 0x41, 0x51, 0x21, 0x5E },   // U+0051 (Q)
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 },   // U+0052 (R)
+    { 0x46, 0x49, 0x49, 0x49, 0x31 },   // U+0053 (S)
+    { 0x01, 0x01, 0x7F, 0x01, 0x01 },   // U+0054 (T)
+    { 0x3F, 0x40, 0x40, 0x40, 0x3F },   // U+0055 (U)
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F },   // U+0056 (V)
+    { 0x3F, 0x40, 0x38, 0x40, 0x3F },   // U+0057 (W)
+    { 0x63, 0x14, 0x08, 0x14, 0x63 },   // U+0058 (X)
+    { 0x07, 0x08, 0x70, 0x08, 0x07 },   // U+0059 (Y)
+    { 0x61, 0x51, 0x49, 0x45, 0x43 },   // U+005A (Z)
+    { 0x00, 0x7F, 0x41, 0x41, 0x00 },   // U+005B ([)
+    { 0x02, 0x04, 0x08, 0x10, 0x20 },   // U+005C (\)
+    { 0x00, 0x41, 0x41, 0x7F, 0x00 },   // U+005D (])
+    { 0x04, 0x02, 0x01, 0x02, 0x04 },   // U+005E (^)
+    { 0x40, 0x40, 0x40, 0x40, 0x40 },   // U+005F (_)
+    { 0x00, 0x01, 0x02, 0x04, 0x00 },   // U+0060 (`)
+    { 0x20, 0x54, 0x54, 0x54, 0x78 },   // U+0061 (a)
+    { 0x7F, 0x48, 0x44, 0x44, 0x38 },   // U+0062 (b)
+    { 0x38, 0x44, 0x44, 0x44, 0x20 },   // U+0063 (c)
+    { 0x38, 0x44, 0x44, 0x48, 0x7F },   // U+0064 (d)
+    { 0x38, 0x54, 0x54, 0x54, 0x18 },   // U+0065 (e)
+    { 0x08, 0x7E, 0x09, 0x01, 0x02 },   // U+0066 (f)
+    { 0x0C, 0x52, 0x52, 0x52, 0x3E },   // U+0067 (g)
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 },   // U+0068 (h)
+    { 0x00, 0x44, 0x7D, 0x40, 0x00 },   // U+0069 (i)
+    { 0x20, 0x40, 0x44, 0x3D, 0x00 },   // U+006A (j)
+    { 0x7F, 0x10, 0x28, 0x44, 0x00 },   // U+006B (k)
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 },   // U+006C (l)
+    { 0x7C, 0x04, 0x18, 0x04, 0x78 },   // U+006D (m)
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 },   // U+006E (n)
+    { 0x38, 0x44, 0x44, 0x44, 0x38 },   // U+006F (o)
+    { 0x7C, 0x14, 0x14, 0x14, 0x08 },   // U+0070 (p)
+    { 0x08, 0x14, 0x14, 0x18, 0x7C },   // U+0071 (q)
+    { 0x7C, 0x08, 0x04, 0x04, 0x08 },   // U+0072 (r)
+    { 0x48, 0x54, 0x54, 0x54, 0x20 },   // U+0073 (s)
+    { 0x04, 0x3F, 0x44, 0x40, 0x20 },   // U+0074 (t)
+    { 0x3C, 0x40, 0x40, 0x20, 0x7C },   // U+0075 (u)
+    { 0x1C, 0x20, 0x40, 0x20, 0x1C },   // U+0076 (v)
+    { 0x3C, 0x40, 0x30, 0x40, 0x3C },   // U+0077 (w)
+    { 0x44, 0x28, 0x10, 0x28, 0x44 },   // U+0078 (x)
+    { 0x0C, 0x50, 0x50, 0x50, 0x3C },   // U+0079 (y)
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 },   // U+007A (z)
+    { 0x00, 0x08, 0x36, 0x41, 0x00 },   // U+007B ({)
+    { 0x00, 0x00, 0x7F, 0x00, 0x00 },   // U+007C (|)
+    { 0x00, 0x41, 0x36, 0x08, 0x00 },   // U+007D (})
+    { 0x08, 0x04, 0x08, 0x10, 0x08 },   // U+007E (~)
+    { 0x00, 0x06, 0x09, 0x09, 0x06 },   // U+007F (°)
+};
+
+#endif /* FONT5X7_H_ */
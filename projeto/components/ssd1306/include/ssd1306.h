@@ -1,8 +1,11 @@
 #ifndef SSD1306_H
 #define SSD1306_H
 
+#include <stdint.h>
+#include <stdbool.h>
 #include "esp_err.h"
-#include "driver/i2c.h"
+#include "freertos/FreeRTOS.h"
+#include "i2c_bus.h"
 
 // Configurações do display SSD1306
 #define OLED_I2C_ADDRESS 0x3C  // Endereço I2C do display
@@ -21,13 +24,58 @@
 #define OLED_CMD_SET_CHARGE_PUMP 0x8D
 #define OLED_CMD_SET_SEGMENT_REMAP 0xA1
 #define OLED_CMD_SET_COM_SCAN_MODE 0xC8
+#define OLED_CMD_SET_MEMORY_ADDR_MODE 0x20
+#define OLED_CMD_SET_PAGE_START 0xB0
+#define OLED_CMD_SET_COLUMN_LOW 0x00
+#define OLED_CMD_SET_COLUMN_HIGH 0x10
+#define OLED_CMD_SET_COLUMN_RANGE 0x21  // + coluna inicial, coluna final
+#define OLED_CMD_SET_PAGE_RANGE 0x22    // + página inicial, página final
 
-// 🔧 Inicialização do SSD1306
+// Modos de endereçamento (argumento de OLED_CMD_SET_MEMORY_ADDR_MODE)
+#define OLED_ADDR_MODE_HORIZONTAL 0x00
+#define OLED_ADDR_MODE_PAGE 0x02
+
+// Maior sequência aceita por ssd1306_send_commands()
+#define SSD1306_MAX_CMD_STREAM 32
+
+// 📊 Contadores de tráfego no barramento (desde o ssd1306_init)
+typedef struct {
+    uint32_t transactions;  // Transações I2C (START ... STOP)
+    uint32_t bytes;         // Bytes no fio, incluindo o byte de endereço
+    uint32_t flushes;       // Quadros que efetivamente enviaram algo ao display
+    uint32_t frames_submitted;  // Quadros entregues à task do display
+    uint32_t frames_coalesced;  // Quadros substituídos antes de serem enviados
+    uint32_t frames_dropped;    // Quadros descartados com o painel fora do ar
+    uint32_t offline_events;    // Quantas vezes o painel caiu
+    uint32_t recoveries;        // Quantas vezes voltou
+    uint32_t last_recovery_ms;  // Tempo fora do ar na última queda
+} ssd1306_stats_t;
+
+// 🩺 Estado de saúde do painel
+typedef enum {
+    SSD1306_STATE_OFFLINE = 0,  // Sem resposta: quadros descartados, sonda com backoff
+    SSD1306_STATE_ONLINE,       // Respondendo normalmente
+} ssd1306_state_t;
+
+// 🔧 Inicialização do SSD1306 (não bloqueia se o painel estiver ausente)
 esp_err_t ssd1306_init();
 
-// 🔄 Reinicializa o barramento I2C se houver falha e espera reconexão
+// 🖥 Cria a task que inicializa o display e passa a ser dona do I2C dele.
+// A partir daí ssd1306_flush() só entrega o quadro à task e retorna.
+esp_err_t ssd1306_task_start(UBaseType_t priority);
+
+// 🔄 Marca o painel como fora do ar e pede uma sonda imediata (não bloqueia)
 void ssd1306_reconnect();
 
+// 🩺 Estado atual do painel
+ssd1306_state_t ssd1306_get_state();
+
+// 📜 Envia vários comandos numa única transação I2C (CMD_STREAM)
+esp_err_t ssd1306_send_commands(const uint8_t *commands, size_t len);
+
+// 🔲 Define a janela de escrita: colunas e páginas, ambas inclusivas
+esp_err_t ssd1306_set_window(uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end);
+
 // 🔍 Verifica se o display SSD1306 está conectado
 bool ssd1306_check_connection();
 
@@ -44,4 +92,36 @@ void ssd1306_display_text(const char *text);
 // 🖼 Exibe uma imagem na tela
 void ssd1306_display_image(const uint8_t *image, uint8_t width, uint8_t height);
 
+// ----------------------
+// Framebuffer em RAM (128x64 = 1 KB)
+// As funções de desenho só alteram a RAM; nada vai para o display
+// até ssd1306_flush(), que envia apenas as páginas/colunas alteradas.
+// ----------------------
+
+// 🧽 Apaga o framebuffer
+void ssd1306_fb_clear();
+
+// ✏️ Liga/desliga um pixel
+void ssd1306_draw_pixel(uint8_t x, uint8_t y, bool on);
+
+// ⬛ Preenche (on) ou apaga (!on) um retângulo
+void ssd1306_fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool on);
+
+// 🔤 Desenha um caractere 8x8 na coluna x da página (linha de texto) page
+void ssd1306_draw_char(uint8_t x, uint8_t page, char c);
+
+// 🔤 Desenha um texto 8x8; retorna a coluna após o último caractere
+uint8_t ssd1306_draw_string(uint8_t x, uint8_t page, const char *text);
+
+// 🖼 Copia uma imagem organizada em páginas (width bytes por página)
+void ssd1306_draw_bitmap(uint8_t x, uint8_t page, const uint8_t *image, uint8_t width, uint8_t pages);
+
+// 🚀 Envia ao display somente o que mudou desde o último flush.
+// Com a task do display ativa, não bloqueia: quadros seguidos são
+// agrupados e só o mais recente é enviado.
+esp_err_t ssd1306_flush();
+
+// 📊 Lê os contadores de tráfego
+void ssd1306_get_stats(ssd1306_stats_t *stats);
+
 #endif // SSD1306_H
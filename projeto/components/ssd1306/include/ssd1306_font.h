@@ -0,0 +1,31 @@
+#ifndef SSD1306_FONT_H
+#define SSD1306_FONT_H
+
+#include <stdint.h>
+#include "ssd1306.h"
+
+// 🔠 Fontes disponíveis para ssd1306_draw_text()
+typedef enum {
+    SSD1306_FONT_8X8 = 0,     // font8x8_basic, 8 px de avanço
+    SSD1306_FONT_5X7,         // Compacta, 6 px de avanço (5 + espaço)
+    SSD1306_FONT_DIGITS_2X,   // 5x7 ampliada 2x (10x14): leituras grandes
+    SSD1306_FONT_DIGITS_3X,   // 5x7 ampliada 3x (15x21): leituras enormes
+} ssd1306_font_t;
+
+// Caracteres pré-calculados nas fontes ampliadas; os demais saem em branco.
+// FONT5X7 "\x7F" é o símbolo de grau.
+#define SSD1306_FONT_DIGITS_CHARSET " +-.0123456789:%C\x7F"
+
+// 📏 Altura em pixels e avanço horizontal por caractere
+uint8_t ssd1306_font_height(ssd1306_font_t font);
+uint8_t ssd1306_font_advance(ssd1306_font_t font);
+
+// 📏 Largura em pixels que o texto ocupará
+uint16_t ssd1306_text_width(const char *text, ssd1306_font_t font);
+
+// ✍️ Desenha texto no framebuffer com o canto superior esquerdo em (x, y),
+// em qualquer posição de pixel (não precisa estar alinhado à página).
+// O fundo das células é apagado. Retorna a coluna após o último caractere.
+uint8_t ssd1306_draw_text(uint8_t x, uint8_t y, const char *text, ssd1306_font_t font);
+
+#endif // SSD1306_FONT_H
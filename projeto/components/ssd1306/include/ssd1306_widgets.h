@@ -0,0 +1,73 @@
+#ifndef SSD1306_WIDGETS_H
+#define SSD1306_WIDGETS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+#include "ssd1306_font.h"
+
+// ----------------------
+// Widgets sobre o framebuffer
+// Cada widget só redesenha a própria caixa (x, y, w, h) e só quando o valor
+// exibido muda; o flush compara com o que já está no display e envia apenas
+// as colunas alteradas. Nenhum widget faz I2C: chame ssd1306_flush() depois
+// de atualizar os widgets do quadro.
+// ----------------------
+
+// Maior largura de sparkline (uma amostra por coluna)
+#define SSD1306_SPARKLINE_MAX OLED_WIDTH
+
+// 🔢 Leitura numérica: valor + unidade, alinhado à direita na caixa
+typedef struct {
+    uint8_t x, y, w;
+    ssd1306_font_t font;
+    uint8_t decimals;
+    const char *unit;      // Ex.: "\x7F" "C" (grau) ou "%"; pode ser NULL
+    char shown[16];        // Texto atualmente desenhado
+} ssd1306_readout_t;
+
+// 📊 Barra horizontal com moldura (0..100 %)
+typedef struct {
+    uint8_t x, y, w, h;
+    uint8_t fill;          // Colunas preenchidas atualmente (dentro da moldura)
+    bool drawn;            // Moldura já desenhada
+} ssd1306_hbar_t;
+
+// 📈 Sparkline: últimas w amostras, uma por coluna
+typedef struct {
+    uint8_t x, y, w, h;
+    float min, max;        // Faixa fixa; com autoscale é recalculada a cada amostra
+    bool autoscale;
+    float samples[SSD1306_SPARKLINE_MAX];
+    uint8_t head;          // Próxima posição a escrever
+    uint8_t count;
+} ssd1306_sparkline_t;
+
+// 🎯 Indicador de inclinação: círculo com cruz e um ponto em (roll, pitch)
+typedef struct {
+    uint8_t cx, cy, r;
+    float range_deg;       // Inclinação que leva o ponto até a borda
+    int8_t dot_x, dot_y;   // Deslocamento atual do ponto em relação ao centro
+    bool drawn;
+} ssd1306_tilt_t;
+
+// 🔢 Leitura numérica
+void ssd1306_readout_init(ssd1306_readout_t *w, uint8_t x, uint8_t y, uint8_t width,
+                          ssd1306_font_t font, uint8_t decimals, const char *unit);
+void ssd1306_readout_set(ssd1306_readout_t *w, float value);
+void ssd1306_readout_set_text(ssd1306_readout_t *w, const char *text);
+
+// 📊 Barra horizontal
+void ssd1306_hbar_init(ssd1306_hbar_t *bar, uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+void ssd1306_hbar_set(ssd1306_hbar_t *bar, uint8_t percent);
+
+// 📈 Sparkline (min == max liga o autoscale)
+void ssd1306_sparkline_init(ssd1306_sparkline_t *sl, uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+                            float min, float max);
+void ssd1306_sparkline_push(ssd1306_sparkline_t *sl, float value);
+
+// 🎯 Indicador de inclinação
+void ssd1306_tilt_init(ssd1306_tilt_t *tilt, uint8_t cx, uint8_t cy, uint8_t r, float range_deg);
+void ssd1306_tilt_set(ssd1306_tilt_t *tilt, float roll_deg, float pitch_deg);
+
+#endif // SSD1306_WIDGETS_H
@@ -1,57 +1,141 @@
 #include "ssd1306.h"
+#include "ssd1306_priv.h"
 #include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
-#include "driver/i2c.h"
+#include "esp_timer.h"
+#include "i2c_bus.h"
 #include "font8x8_basic.h"
 
 #define TAG "SSD1306"
 
-// ----------------------
-// Definições típicas p/ SSD1306
-// (ajuste ou remova se já estiverem no seu ssd1306.h)
-#define OLED_CONTROL_BYTE_CMD_SINGLE     0x80
-#define OLED_CONTROL_BYTE_DATA_STREAM    0x40
-#define OLED_CMD_DISPLAY_OFF            0xAE
-#define OLED_CMD_SET_CHARGE_PUMP        0x8D
-#define OLED_CMD_SET_SEGMENT_REMAP      0xA1
-#define OLED_CMD_SET_COM_SCAN_MODE      0xC8
-#define OLED_CMD_DISPLAY_ON             0xAF
-
-#define OLED_WIDTH   128
-#define OLED_HEIGHT  64
-#define OLED_PAGES   (OLED_HEIGHT / 8)
-// ----------------------
-
 // Ajuste os pinos de acordo com seu hardware
+#define SSD1306_I2C_PORT I2C_NUM_0
 #define SDA_PIN GPIO_NUM_3
 #define SCL_PIN GPIO_NUM_8
-#define OLED_I2C_ADDRESS 0x3C
 #define I2C_FREQ_HZ 400000  // Ajustado para 400kHz
+#define SSD1306_I2C_TIMEOUT_MS 100
 
 static uint8_t erro_contador = 0;
+static i2c_bus_device_handle_t s_dev = NULL;
+
+// ----------------------
+// Saúde do display
+// Uma falha de I2C só marca o painel como OFFLINE; ninguém espera por ele.
+// Enquanto estiver fora, os quadros são descartados (contados) e a
+// reconexão é testada em segundo plano com backoff exponencial. Quando o
+// painel volta, a sequência de init é reenviada e o último quadro é
+// redesenhado por completo.
+// ----------------------
+#define SSD1306_BACKOFF_MIN_MS 250
+#define SSD1306_BACKOFF_MAX_MS 8000
 
-// 🔧 **Inicializa o barramento I2C (SSD1306)**
+static ssd1306_state_t s_state = SSD1306_STATE_OFFLINE;
+static uint32_t s_backoff_ms = SSD1306_BACKOFF_MIN_MS;
+static int64_t s_next_probe_us = 0;
+static int64_t s_offline_since_us = 0;
+
+// ----------------------
+// Framebuffer
+// s_framebuffer: o que queremos mostrar
+// s_shadow:      o que já foi enviado ao display no último flush
+// s_dirty_pages: bit N = página N foi tocada desde o último flush
+// ----------------------
+static uint8_t s_framebuffer[OLED_PAGES][OLED_WIDTH];
+static uint8_t s_shadow[OLED_PAGES][OLED_WIDTH];
+static uint8_t s_dirty_pages = 0;
+static bool s_shadow_valid = false;  // false => o próximo flush envia a tela inteira
+static ssd1306_stats_t s_stats;
+// Contadores escritos pela task do display, por quem chama ssd1306_flush()
+// e pelo caminho de submissão: toda escrita e a cópia passam pelo spinlock
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// ----------------------
+// Flush assíncrono
+// Cada faixa vira dois pedidos (janela + dados) entregues ao i2c_bus sem
+// esperar um pelo outro; o quadro inteiro é enfileirado de uma vez e só no
+// fim a task espera a última conclusão. Os buffers ficam aqui até lá.
+// ----------------------
+#define SSD1306_WINDOW_CMD_LEN 7
+#define SSD1306_ASYNC_DEPTH (2 * OLED_PAGES)  // Pior caso: uma faixa por página
+
+typedef struct {
+    uint8_t col_min, col_max, page_min, page_max;
+} ssd1306_band_t;
+
+static uint8_t s_tx_buffer[OLED_PAGES * OLED_WIDTH + OLED_PAGES];  // control byte por faixa + dados
+static size_t s_tx_used = 0;
+static uint8_t s_window_cmds[OLED_PAGES][SSD1306_WINDOW_CMD_LEN];
+static ssd1306_band_t s_bands[OLED_PAGES];
+static uint8_t s_band_count = 0;
+
+static portMUX_TYPE s_flush_lock = portMUX_INITIALIZER_UNLOCKED;
+static int s_flush_inflight = 0;
+static esp_err_t s_flush_err = ESP_OK;
+static SemaphoreHandle_t s_flush_done = NULL;
+
+// Custo aproximado, em bytes no fio, de abrir mais uma janela no flush:
+// endereço + CMD_STREAM + 0x21/0x22 com argumentos, e endereço + DATA_STREAM
+#define SSD1306_BAND_OVERHEAD 10
+
+// ----------------------
+// Task do display
+// Quem desenha copia as páginas sujas para s_pending e avisa a task pela
+// fila (tamanho 1, xQueueOverwrite): se a task ainda não consumiu o quadro
+// anterior, o novo simplesmente o substitui (o mais recente vence).
+// Só a task do display faz I2C, então quem desenha nunca espera o barramento.
+// ----------------------
+static uint8_t s_pending[OLED_PAGES][OLED_WIDTH];
+static uint8_t s_pending_dirty = 0;
+static bool s_pending_full = false;
+static uint8_t s_tx_frame[OLED_PAGES][OLED_WIDTH];
+static SemaphoreHandle_t s_pending_mutex = NULL;
+static QueueHandle_t s_frame_queue = NULL;
+static TaskHandle_t s_display_task = NULL;
+static uint32_t s_frame_seq = 0;
+
+// 🔧 **Registra o SSD1306 no gerenciador do barramento I2C**
+// O display fica em prioridade normal: leituras de sensores na mesma porta
+// passam na frente dos flushes que ainda estão na fila.
 esp_err_t i2c_ssd1306_init(){
-    i2c_config_t i2c_conf = {
-        .mode = I2C_MODE_MASTER,
-        .sda_io_num = SDA_PIN,
-        .scl_io_num = SCL_PIN,
-        .sda_pullup_en = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = I2C_FREQ_HZ
+    if (s_dev != NULL) {
+        return ESP_OK;
+    }
+
+    const i2c_bus_config_t bus_conf = {
+        .port = SSD1306_I2C_PORT,
+        .sda = SDA_PIN,
+        .scl = SCL_PIN,
+        .task_priority = 6,
     };
-    i2c_param_config(I2C_NUM_0, &i2c_conf);
-    return i2c_driver_install(I2C_NUM_0, I2C_MODE_MASTER, 0, 0, 0);
+    esp_err_t err = i2c_bus_init(&bus_conf);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    const i2c_bus_device_config_t dev_conf = {
+        .name = "ssd1306",
+        .address = OLED_I2C_ADDRESS,
+        .clk_hz = I2C_FREQ_HZ,
+        .timeout_ms = SSD1306_I2C_TIMEOUT_MS,
+        .priority = I2C_BUS_PRIORITY_NORMAL,
+        .async_depth = SSD1306_ASYNC_DEPTH,
+    };
+    if (s_flush_done == NULL) {
+        s_flush_done = xSemaphoreCreateBinary();
+        if (s_flush_done == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    return i2c_bus_add_device(SSD1306_I2C_PORT, &dev_conf, &s_dev);
 }
 
 // 🔍 **Verifica se o SSD1306 está conectado**
 bool ssd1306_check_connection() {
-    uint8_t test_data = 0x00;
-    esp_err_t err = i2c_master_write_read_device(I2C_NUM_0, 
-                                                OLED_I2C_ADDRESS, 
-                                                &test_data, 1, 
-                                                &test_data, 1, 
-                                                pdMS_TO_TICKS(100));
+    esp_err_t err = (s_dev != NULL) ? i2c_bus_probe(s_dev) : ESP_ERR_INVALID_STATE;
 
     if (err == ESP_OK) {
         ESP_LOGI(TAG, "✅ SSD1306 detectado!");
@@ -62,150 +146,579 @@ bool ssd1306_check_connection() {
     }
 }
 
-// 🔧 **Reinicializa o barramento I2C e verifica conexão**
+// ⚠️ **Marca o painel como desconectado e agenda a primeira sonda**
+static void ssd1306_mark_offline(esp_err_t err) {
+    if (s_state == SSD1306_STATE_OFFLINE) {
+        return;
+    }
+    ESP_LOGW(TAG, "⚠️ SSD1306 fora do ar (%s). Quadros serão descartados até reconectar.", esp_err_to_name(err));
+    s_state = SSD1306_STATE_OFFLINE;
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.offline_events++;
+    portEXIT_CRITICAL(&s_stats_lock);
+    s_offline_since_us = esp_timer_get_time();
+    s_backoff_ms = SSD1306_BACKOFF_MIN_MS;
+    s_next_probe_us = s_offline_since_us + s_backoff_ms * 1000LL;
+}
+
+// 🔧 **Pede uma nova tentativa de conexão (não bloqueia)**
+// A sonda acontece na próxima oportunidade da task do display (ou do
+// próximo flush, sem task).
 void ssd1306_reconnect() {
-    ESP_LOGW(TAG, "⚠️ Erro de conexão com SSD1306. Tentando reconectar...");
+    ssd1306_mark_offline(ESP_FAIL);
+    s_next_probe_us = 0;
+}
 
-    while (!ssd1306_check_connection()) {
-        ESP_LOGE(TAG, "❌ SSD1306 desconectado! Aguardando reconexão...");
-        vTaskDelay(pdMS_TO_TICKS(1000));  // Aguarda reconexão
-    }
+ssd1306_state_t ssd1306_get_state() {
+    return s_state;
+}
 
-    ESP_LOGI(TAG, "🔄 SSD1306 reconectado! Reiniciando ESP32...");
-    esp_restart();  // Reinicia o ESP32 assim que o display for reconectado
+// 📤 **Transação I2C com contagem de tráfego**
+static esp_err_t ssd1306_write(const uint8_t *buffer, size_t len) {
+    if (s_dev == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = i2c_bus_write(s_dev, buffer, len);
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.transactions++;
+    s_stats.bytes += len + 1;  // +1: byte de endereço
+    portEXIT_CRITICAL(&s_stats_lock);
+    return err;
 }
 
-// 🔧 **Envia comandos para o SSD1306**
-static esp_err_t ssd1306_send_command(uint8_t command) {
-    uint8_t buffer[2] = {OLED_CONTROL_BYTE_CMD_SINGLE, command};
-    esp_err_t err = i2c_master_write_to_device(I2C_NUM_0, 
-                                               OLED_I2C_ADDRESS, 
-                                               buffer, sizeof(buffer), 
-                                               pdMS_TO_TICKS(100));
+// 🔧 **Envia uma sequência de comandos numa única transação**
+// Com o control byte CMD_STREAM (Co=0, D/C#=0) todos os bytes seguintes são
+// comandos: um só START/endereço/STOP para a sequência inteira.
+esp_err_t ssd1306_send_commands(const uint8_t *commands, size_t len) {
+    uint8_t buffer[SSD1306_MAX_CMD_STREAM + 1];
+    if (len == 0 || len > SSD1306_MAX_CMD_STREAM) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    buffer[0] = OLED_CONTROL_BYTE_CMD_STREAM;
+    memcpy(&buffer[1], commands, len);
+    esp_err_t err = ssd1306_write(buffer, len + 1);
 
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "⚠️ Erro ao enviar comando 0x%X: %s", command, esp_err_to_name(err));
-        ssd1306_reconnect();  // **Se falhar, tenta reconectar**
+        ESP_LOGE(TAG, "⚠️ Erro ao enviar %u comandos (0x%X...): %s", (unsigned)len, commands[0], esp_err_to_name(err));
+        ssd1306_mark_offline(err);
     }
     return err;
 }
 
+// 🔲 **Define a janela de escrita (colunas e páginas, inclusivas)**
+esp_err_t ssd1306_set_window(uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end) {
+    const uint8_t commands[] = {
+        OLED_CMD_SET_COLUMN_RANGE, col_start, col_end,
+        OLED_CMD_SET_PAGE_RANGE, page_start, page_end,
+    };
+    return ssd1306_send_commands(commands, sizeof(commands));
+}
+
+// 🔧 **Envia a sequência de configuração do painel**
+static esp_err_t ssd1306_configure() {
+    // Endereçamento horizontal: o flush abre uma janela (0x21/0x22) e manda
+    // todos os dados dela numa única rajada
+    static const uint8_t init_sequence[] = {
+        OLED_CMD_DISPLAY_OFF,
+        OLED_CMD_SET_MEMORY_ADDR_MODE, OLED_ADDR_MODE_HORIZONTAL,
+        OLED_CMD_SET_CHARGE_PUMP, 0x14,
+        OLED_CMD_SET_SEGMENT_REMAP,
+        OLED_CMD_SET_COM_SCAN_MODE,
+        OLED_CMD_DISPLAY_ON,
+    };
+    esp_err_t err = ssd1306_send_commands(init_sequence, sizeof(init_sequence));
+
+    // A GDDRAM tem conteúdo indefinido após o power-up: força envio completo
+    s_shadow_valid = false;
+    return err;
+}
+
+// 🔁 **Sonda o painel se o backoff permitir; true se voltou ao ar**
+static bool ssd1306_try_recover() {
+    int64_t now = esp_timer_get_time();
+    if (now < s_next_probe_us) {
+        return false;
+    }
+
+    // Continua OFFLINE durante a reconfiguração: falhar aqui não conta como nova queda
+    if (ssd1306_check_connection() && ssd1306_configure() == ESP_OK) {
+        s_state = SSD1306_STATE_ONLINE;
+        uint32_t offline_ms = (uint32_t)((esp_timer_get_time() - s_offline_since_us) / 1000);
+        portENTER_CRITICAL(&s_stats_lock);
+        s_stats.recoveries++;
+        s_stats.last_recovery_ms = offline_ms;
+        portEXIT_CRITICAL(&s_stats_lock);
+        ESP_LOGI(TAG, "🔄 SSD1306 reconectado após %lu ms", (unsigned long)offline_ms);
+        s_backoff_ms = SSD1306_BACKOFF_MIN_MS;
+        return true;
+    }
+
+    s_backoff_ms = (s_backoff_ms * 2 > SSD1306_BACKOFF_MAX_MS) ? SSD1306_BACKOFF_MAX_MS : s_backoff_ms * 2;
+    s_next_probe_us = esp_timer_get_time() + s_backoff_ms * 1000LL;
+    return false;
+}
+
 // 🔧 **Inicializa o SSD1306**
-esp_err_t ssd1306_init() 
+// Não bloqueia esperando o painel: se ele não responder, fica OFFLINE e a
+// reconexão é tentada depois.
+esp_err_t ssd1306_init()
 {
     // Se necessário, inicialize o I2C para o SSD1306
-    i2c_ssd1306_init();
+    esp_err_t bus_err = i2c_ssd1306_init();
+    if (bus_err != ESP_OK) {
+        ESP_LOGE(TAG, "❌ Barramento I2C do SSD1306 indisponível: %s", esp_err_to_name(bus_err));
+        return bus_err;
+    }
 
     vTaskDelay(pdMS_TO_TICKS(100));
 
+    s_offline_since_us = esp_timer_get_time();
     if (!ssd1306_check_connection()) {
-        ssd1306_reconnect();
+        s_state = SSD1306_STATE_OFFLINE;
+        s_next_probe_us = s_offline_since_us + s_backoff_ms * 1000LL;
+        ESP_LOGE(TAG, "❌ SSD1306 ausente no init; tentando de novo em segundo plano");
+        return ESP_ERR_NOT_FOUND;
     }
 
-    esp_err_t err = ESP_OK;
-
-    err |= ssd1306_send_command(OLED_CMD_DISPLAY_OFF);
-    err |= ssd1306_send_command(0x20);  // Modo de endereçamento
-    err |= ssd1306_send_command(0x00);  // Horizontal
-    err |= ssd1306_send_command(OLED_CMD_SET_CHARGE_PUMP);
-    err |= ssd1306_send_command(0x14);
-    err |= ssd1306_send_command(OLED_CMD_SET_SEGMENT_REMAP);
-    err |= ssd1306_send_command(OLED_CMD_SET_COM_SCAN_MODE);
-    err |= ssd1306_send_command(OLED_CMD_DISPLAY_ON);
+    s_state = SSD1306_STATE_ONLINE;
+    esp_err_t err = ssd1306_configure();
 
     if (err == ESP_OK) {
         ESP_LOGI(TAG, "✅ SSD1306 inicializado com sucesso!");
         erro_contador = 0;
     } else {
         ESP_LOGE(TAG, "❌ Falha ao inicializar SSD1306!");
-        ssd1306_reconnect();
     }
     return err;
 }
 
-// 🔧 **Limpa a tela do SSD1306**
-void ssd1306_clear_screen() {
-    // Cada "page" equivale a 8 linhas do display
-    for (uint8_t page = 0; page < OLED_PAGES; page++) {
-        // Buffer: primeiro byte é o CONTROL_BYTE, o resto são dados
-        uint8_t buffer[OLED_WIDTH + 1];
-        buffer[0] = OLED_CONTROL_BYTE_DATA_STREAM;
-        memset(&buffer[1], 0x00, OLED_WIDTH);
-
-        esp_err_t err = i2c_master_write_to_device(I2C_NUM_0, 
-                                                   OLED_I2C_ADDRESS, 
-                                                   buffer, sizeof(buffer), 
-                                                   pdMS_TO_TICKS(100));
-        if (err != ESP_OK) {
-            ssd1306_reconnect();
+// ----------------------
+// Primitivas de desenho (somente RAM)
+// ----------------------
+
+uint8_t (*ssd1306_fb_pages(void))[OLED_WIDTH] {
+    return s_framebuffer;
+}
+
+void ssd1306_fb_mark_dirty(uint8_t page_mask) {
+    s_dirty_pages |= page_mask;
+}
+
+void ssd1306_fb_clear() {
+    memset(s_framebuffer, 0x00, sizeof(s_framebuffer));
+    s_dirty_pages = 0xFF;
+}
+
+void ssd1306_draw_pixel(uint8_t x, uint8_t y, bool on) {
+    if (x >= OLED_WIDTH || y >= OLED_HEIGHT) {
+        return;
+    }
+
+    uint8_t page = y / 8;
+    uint8_t mask = 1 << (y & 0x07);
+    if (on) {
+        s_framebuffer[page][x] |= mask;
+    } else {
+        s_framebuffer[page][x] &= ~mask;
+    }
+    s_dirty_pages |= 1 << page;
+}
+
+void ssd1306_fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool on) {
+    if (x >= OLED_WIDTH || y >= OLED_HEIGHT) {
+        return;
+    }
+    if (w > OLED_WIDTH - x) w = OLED_WIDTH - x;
+    if (h > OLED_HEIGHT - y) h = OLED_HEIGHT - y;
+
+    // Trabalha uma página por vez com uma máscara vertical em vez de pixel a pixel
+    uint16_t y_end = y + h;
+    for (uint16_t row = y; row < y_end; ) {
+        uint8_t page = row / 8;
+        uint8_t first_bit = row & 0x07;
+        uint8_t last_bit = (y_end - page * 8 >= 8) ? 7 : (uint8_t)(y_end - page * 8 - 1);
+        uint8_t mask = (uint8_t)((0xFF << first_bit) & (0xFF >> (7 - last_bit)));
+
+        for (uint8_t col = x; col < x + w; col++) {
+            if (on) {
+                s_framebuffer[page][col] |= mask;
+            } else {
+                s_framebuffer[page][col] &= ~mask;
+            }
         }
+        s_dirty_pages |= 1 << page;
+        row = (page + 1) * 8;
     }
 }
 
-// 🔧 **Exibe texto no display**
-void ssd1306_display_text(const char *text) {
-    if (!ssd1306_check_connection()) {
-        ssd1306_reconnect();
-    }
-
-    ssd1306_clear_screen();
-
-    // Definir posição fixa no canto superior esquerdo (0,0)
-    ssd1306_send_command(0xB0);
-    // Coluna baixa
-    ssd1306_send_command(0x00); 
-    // Coluna alta
-    ssd1306_send_command(0x10); 
-    for (uint8_t i = 0; i < strlen(text); i++) {
-        uint8_t char_map[8];
-        memcpy(char_map, font8x8_basic_tr[(uint8_t)text[i]], 8);
-        
-        uint8_t buffer[9];
-        buffer[0] = OLED_CONTROL_BYTE_DATA_STREAM;
-        memcpy(&buffer[1], char_map, 8);
-
-        if (i2c_master_write_to_device(I2C_NUM_0, 
-                                       OLED_I2C_ADDRESS, 
-                                       buffer, sizeof(buffer), 
-                                       pdMS_TO_TICKS(100)) != ESP_OK) {
-            ssd1306_reconnect();
+void ssd1306_draw_char(uint8_t x, uint8_t page, char c) {
+    if (page >= OLED_PAGES || x > OLED_WIDTH - 8) {
+        return;
+    }
+    memcpy(&s_framebuffer[page][x], font8x8_basic_tr[(uint8_t)c & 0x7F], 8);
+    s_dirty_pages |= 1 << page;
+}
+
+uint8_t ssd1306_draw_string(uint8_t x, uint8_t page, const char *text) {
+    for (const char *p = text; *p != '\0' && x <= OLED_WIDTH - 8; p++) {
+        ssd1306_draw_char(x, page, *p);
+        x += 8;
+    }
+    return x;
+}
+
+void ssd1306_draw_bitmap(uint8_t x, uint8_t page, const uint8_t *image, uint8_t width, uint8_t pages) {
+    if (x >= OLED_WIDTH || page >= OLED_PAGES) {
+        return;
+    }
+    uint8_t copy_width = (width > OLED_WIDTH - x) ? OLED_WIDTH - x : width;
+
+    for (uint8_t p = 0; p < pages && page + p < OLED_PAGES; p++) {
+        memcpy(&s_framebuffer[page + p][x], &image[p * width], copy_width);
+        s_dirty_pages |= 1 << (page + p);
+    }
+}
+
+// ----------------------
+// Flush incremental
+// ----------------------
+
+// ✅ Conclusão de um pedido do flush (contexto da worker do i2c_bus)
+static void ssd1306_tx_done(esp_err_t result, void *ctx) {
+    portENTER_CRITICAL(&s_flush_lock);
+    if (result != ESP_OK && s_flush_err == ESP_OK) {
+        s_flush_err = result;
+    }
+    bool last = (--s_flush_inflight == 0);
+    portEXIT_CRITICAL(&s_flush_lock);
+
+    if (last) {
+        xSemaphoreGive(s_flush_done);
+    }
+}
+
+// 📤 Enfileira um pedido do flush sem esperar
+static esp_err_t ssd1306_write_async(const uint8_t *buffer, size_t len) {
+    if (s_dev == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    portENTER_CRITICAL(&s_flush_lock);
+    s_flush_inflight++;
+    portEXIT_CRITICAL(&s_flush_lock);
+
+    esp_err_t err = i2c_bus_write_async(s_dev, buffer, len, ssd1306_tx_done, NULL);
+    if (err != ESP_OK) {
+        portENTER_CRITICAL(&s_flush_lock);
+        s_flush_inflight--;
+        portEXIT_CRITICAL(&s_flush_lock);
+        return err;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.transactions++;
+    s_stats.bytes += len + 1;  // +1: byte de endereço
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
+}
+
+// 📤 Enfileira um retângulo do quadro (janela + um único burst de dados)
+static esp_err_t ssd1306_flush_band(uint8_t frame[OLED_PAGES][OLED_WIDTH],
+                                    int col_min, int col_max, int page_min, int page_max) {
+    uint8_t *window = s_window_cmds[s_band_count];
+    window[0] = OLED_CONTROL_BYTE_CMD_STREAM;
+    window[1] = OLED_CMD_SET_COLUMN_RANGE;
+    window[2] = col_min;
+    window[3] = col_max;
+    window[4] = OLED_CMD_SET_PAGE_RANGE;
+    window[5] = page_min;
+    window[6] = page_max;
+
+    // Em modo horizontal o ponteiro da GDDRAM percorre a janela coluna a
+    // coluna e passa para a página seguinte ao chegar em col_max
+    size_t width = col_max - col_min + 1;
+    uint8_t *data = &s_tx_buffer[s_tx_used];
+    size_t len = 0;
+    data[len++] = OLED_CONTROL_BYTE_DATA_STREAM;
+    for (int page = page_min; page <= page_max; page++) {
+        memcpy(&data[len], &frame[page][col_min], width);
+        len += width;
+    }
+    s_tx_used += len;
+
+    s_bands[s_band_count++] = (ssd1306_band_t){col_min, col_max, page_min, page_max};
+
+    // Mesmo dispositivo, mesma fila: a janela sempre chega antes dos dados
+    esp_err_t err = ssd1306_write_async(window, SSD1306_WINDOW_CMD_LEN);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return ssd1306_write_async(data, len);
+}
+
+// ⏳ Espera todos os pedidos do quadro e atualiza a sombra com o que chegou
+static esp_err_t ssd1306_flush_wait(uint8_t frame[OLED_PAGES][OLED_WIDTH], esp_err_t submit_err) {
+    // Solta a "guarda" posta no início do quadro
+    portENTER_CRITICAL(&s_flush_lock);
+    bool last = (--s_flush_inflight == 0);
+    portEXIT_CRITICAL(&s_flush_lock);
+    if (!last) {
+        xSemaphoreTake(s_flush_done, portMAX_DELAY);  // A worker sempre conclui (timeout por pedido)
+    }
+
+    esp_err_t err = (submit_err != ESP_OK) ? submit_err : s_flush_err;
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "⚠️ Erro no flush: %s", esp_err_to_name(err));
+        ssd1306_mark_offline(err);
+        return err;
+    }
+
+    for (uint8_t i = 0; i < s_band_count; i++) {
+        const ssd1306_band_t *b = &s_bands[i];
+        for (int page = b->page_min; page <= b->page_max; page++) {
+            memcpy(&s_shadow[page][b->col_min], &frame[page][b->col_min], b->col_max - b->col_min + 1);
         }
     }
+    return ESP_OK;
 }
 
+static esp_err_t ssd1306_flush_frame(uint8_t frame[OLED_PAGES][OLED_WIDTH], uint8_t dirty_pages) {
+    // Colunas diferentes do que está no display, página a página (-1 = nada)
+    int first[OLED_PAGES];
+    int last[OLED_PAGES];
 
-// Define a página (linha)
-// Define a coluna (bits menos significativos)
-// Define a coluna (bits mais significativos)
-void ssd1306_set_cursor(uint8_t x, uint8_t y) {
-    ssd1306_send_command(0xB0 + y); 
-    ssd1306_send_command(0x00 + (x & 0x0F)); 
-    ssd1306_send_command(0x10 + ((x >> 4) & 0x0F)); 
+    for (int page = 0; page < OLED_PAGES; page++) {
+        first[page] = -1;
+        if (!(dirty_pages & (1 << page))) {
+            continue;
+        }
+
+        int f = 0;
+        int l = OLED_WIDTH - 1;
+        if (s_shadow_valid) {
+            while (f < OLED_WIDTH && frame[page][f] == s_shadow[page][f]) {
+                f++;
+            }
+            if (f == OLED_WIDTH) {
+                continue;  // Página tocada, mas idêntica ao display
+            }
+            while (frame[page][l] == s_shadow[page][l]) {
+                l--;
+            }
+        }
+        first[page] = f;
+        last[page] = l;
+    }
+
+    // Agrupa as páginas em faixas retangulares. Widgets em cantos opostos
+    // da tela viram janelas separadas quando isso custa menos bytes no fio
+    // do que um único retângulo envolvendo os dois.
+    int band_start = -1;
+    int band_end = -1;
+    int col_min = 0;
+    int col_max = 0;
+    esp_err_t err = ESP_OK;
+
+    // Guarda: o contador só chega a zero depois que todos foram enfileirados
+    s_flush_inflight = 1;
+    s_flush_err = ESP_OK;
+    s_tx_used = 0;
+    s_band_count = 0;
+
+    for (int page = 0; page < OLED_PAGES; page++) {
+        if (first[page] < 0) {
+            continue;
+        }
+
+        if (band_start >= 0) {
+            int umin = first[page] < col_min ? first[page] : col_min;
+            int umax = last[page] > col_max ? last[page] : col_max;
+            int merged = (umax - umin + 1) * (page - band_start + 1);
+            int split = (col_max - col_min + 1) * (band_end - band_start + 1)
+                      + (last[page] - first[page] + 1) + SSD1306_BAND_OVERHEAD;
+            if (merged <= split) {
+                col_min = umin;
+                col_max = umax;
+                band_end = page;
+                continue;
+            }
+
+            err = ssd1306_flush_band(frame, col_min, col_max, band_start, band_end);
+            if (err != ESP_OK) {
+                return ssd1306_flush_wait(frame, err);
+            }
+        }
+
+        band_start = page;
+        band_end = page;
+        col_min = first[page];
+        col_max = last[page];
+    }
+
+    if (band_start < 0) {
+        s_flush_inflight = 0;
+        return ESP_OK;  // Nada mudou
+    }
+
+    err = ssd1306_flush_band(frame, col_min, col_max, band_start, band_end);
+    err = ssd1306_flush_wait(frame, err);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    s_shadow_valid = true;
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.flushes++;
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
 }
 
+// 📥 **Publica o framebuffer para a task do display (não bloqueia no I2C)**
+static void ssd1306_submit_frame() {
+    xSemaphoreTake(s_pending_mutex, portMAX_DELAY);
+    for (uint8_t page = 0; page < OLED_PAGES; page++) {
+        if (s_dirty_pages & (1 << page)) {
+            memcpy(s_pending[page], s_framebuffer[page], OLED_WIDTH);
+        }
+    }
+    s_pending_dirty |= s_dirty_pages;
+    portENTER_CRITICAL(&s_stats_lock);
+    if (s_pending_full) {
+        s_stats.frames_coalesced++;
+    }
+    s_stats.frames_submitted++;
+    portEXIT_CRITICAL(&s_stats_lock);
+    s_pending_full = true;
+    uint32_t seq = ++s_frame_seq;
+    xSemaphoreGive(s_pending_mutex);
+
+    s_dirty_pages = 0;
+    xQueueOverwrite(s_frame_queue, &seq);
+}
 
-// 🔧 **Exibe imagem no display**
-void ssd1306_display_image(const uint8_t *image, uint8_t width, uint8_t height) {
-    if (!ssd1306_check_connection()) {
-        ssd1306_reconnect();
+// 🖥 **Task dona do barramento do display**
+static void ssd1306_display_task(void *arg) {
+    ssd1306_init();
+
+    uint32_t seq;
+    while (1) {
+        // Fora do ar, acorda no máximo quando a próxima sonda estiver liberada
+        TickType_t wait = portMAX_DELAY;
+        if (s_state == SSD1306_STATE_OFFLINE) {
+            int64_t until_probe_us = s_next_probe_us - esp_timer_get_time();
+            wait = (until_probe_us > 0) ? pdMS_TO_TICKS(until_probe_us / 1000) + 1 : 0;
+        }
+        bool got_frame = (xQueueReceive(s_frame_queue, &seq, wait) == pdTRUE);
+
+        bool full_redraw = false;
+        if (s_state == SSD1306_STATE_OFFLINE) {
+            if (!ssd1306_try_recover()) {
+                // Só conta como descartado se o painel não voltou: com a
+                // sonda bem-sucedida, o mesmo quadro sai no redesenho abaixo
+                if (got_frame) {
+                    portENTER_CRITICAL(&s_stats_lock);
+                    s_stats.frames_dropped++;
+                    portEXIT_CRITICAL(&s_stats_lock);
+                }
+                continue;
+            }
+            full_redraw = true;  // Painel voltou: redesenha o último quadro inteiro
+        } else if (!got_frame) {
+            continue;
+        }
+
+        // Pega o quadro mais recente; quadros intermediários já foram sobrescritos
+        xSemaphoreTake(s_pending_mutex, portMAX_DELAY);
+        uint8_t dirty = full_redraw ? 0xFF : s_pending_dirty;
+        for (uint8_t page = 0; page < OLED_PAGES; page++) {
+            if (dirty & (1 << page)) {
+                memcpy(s_tx_frame[page], s_pending[page], OLED_WIDTH);
+            }
+        }
+        s_pending_dirty = 0;
+        s_pending_full = false;
+        xSemaphoreGive(s_pending_mutex);
+
+        ssd1306_flush_frame(s_tx_frame, dirty);
     }
+}
 
-    ssd1306_clear_screen();
+esp_err_t ssd1306_task_start(UBaseType_t priority) {
+    if (s_display_task != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
 
-    // Número de páginas que a imagem ocupa
-    uint8_t pages = height / 8;
+    s_pending_mutex = xSemaphoreCreateMutex();
+    s_frame_queue = xQueueCreate(1, sizeof(uint32_t));
+    if (s_pending_mutex == NULL || s_frame_queue == NULL) {
+        ESP_LOGE(TAG, "❌ Sem memória para a task do display");
+        return ESP_ERR_NO_MEM;
+    }
+
+    // O primeiro quadro precisa cobrir a tela inteira (GDDRAM indefinida)
+    s_pending_dirty = 0xFF;
+    s_dirty_pages = 0xFF;
+
+    if (xTaskCreate(ssd1306_display_task, "ssd1306_task", 4096, NULL, priority, &s_display_task) != pdPASS) {
+        ESP_LOGE(TAG, "❌ Falha ao criar a task do display");
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
 
-    for (uint8_t page = 0; page < pages; page++) {
-        uint8_t buffer[width + 1];
-        buffer[0] = OLED_CONTROL_BYTE_DATA_STREAM;
-        // Copia a porção referente a cada "page" da imagem
-        memcpy(&buffer[1], &image[page * width], width);
+esp_err_t ssd1306_flush() {
+    if (s_display_task != NULL) {
+        ssd1306_submit_frame();
+        return ESP_OK;
+    }
 
-        if (i2c_master_write_to_device(I2C_NUM_0, 
-                                       OLED_I2C_ADDRESS, 
-                                       buffer, sizeof(buffer), 
-                                       pdMS_TO_TICKS(100)) != ESP_OK) {
-            ssd1306_reconnect();
+    // Sem task: flush síncrono no contexto de quem chamou
+    if (s_state == SSD1306_STATE_OFFLINE) {
+        if (!ssd1306_try_recover()) {
+            portENTER_CRITICAL(&s_stats_lock);
+            s_stats.frames_dropped++;
+            portEXIT_CRITICAL(&s_stats_lock);
+            return ESP_ERR_INVALID_STATE;
         }
+        s_dirty_pages = 0xFF;
+    }
+    esp_err_t err = ssd1306_flush_frame(s_framebuffer, s_dirty_pages);
+    s_dirty_pages = 0;
+    return err;
+}
+
+void ssd1306_get_stats(ssd1306_stats_t *stats) {
+    if (stats) {
+        portENTER_CRITICAL(&s_stats_lock);
+        *stats = s_stats;
+        portEXIT_CRITICAL(&s_stats_lock);
     }
 }
+
+// 🔧 **Limpa a tela do SSD1306**
+void ssd1306_clear_screen() {
+    ssd1306_fb_clear();
+    ssd1306_flush();
+}
+
+// 🔧 **Exibe texto no display**
+// Redesenha o framebuffer inteiro; o flush envia só os glifos que mudaram
+void ssd1306_display_text(const char *text) {
+    ssd1306_fb_clear();
+    ssd1306_draw_string(0, 0, text);
+    ssd1306_flush();
+}
+
+
+// Define a página (linha) e a coluna de início.
+// Em modo horizontal isso é uma janela que vai de (x, y) até o fim da tela.
+void ssd1306_set_cursor(uint8_t x, uint8_t y) {
+    ssd1306_set_window(x, OLED_WIDTH - 1, y, OLED_PAGES - 1);
+}
+
+
+// 🔧 **Exibe imagem no display**
+void ssd1306_display_image(const uint8_t *image, uint8_t width, uint8_t height) {
+    ssd1306_fb_clear();
+    ssd1306_draw_bitmap(0, 0, image, width, height / 8);
+    ssd1306_flush();
+}
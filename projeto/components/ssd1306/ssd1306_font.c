@@ -0,0 +1,165 @@
+#include "ssd1306_font.h"
+#include "ssd1306_priv.h"
+#include <string.h>
+#include <stdbool.h>
+#include "font8x8_basic.h"
+#include "font5x7.h"
+
+// ----------------------
+// Motor de fontes
+// Cada glifo é guardado como colunas de 32 bits: bit 0 = linha de cima do
+// glifo. Para desenhar em y qualquer, a coluna é deslocada de (y & 7) e os
+// até 4 bytes resultantes caem em páginas consecutivas do framebuffer, então
+// cada coluna é um único OR (com máscara para apagar o fundo) em vez de
+// pixel a pixel. As versões 2x/3x dos dígitos são calculadas uma única vez.
+// ----------------------
+
+#define DIGITS_COUNT (sizeof(SSD1306_FONT_DIGITS_CHARSET) - 1)
+#define GLYPH5_COLS 5
+
+static uint32_t s_digits_2x[DIGITS_COUNT][GLYPH5_COLS];
+static uint32_t s_digits_3x[DIGITS_COUNT][GLYPH5_COLS];
+static int8_t s_digit_index[128];  // caractere -> índice em s_digits_*, -1 se ausente
+static bool s_tables_ready = false;
+
+// Replica cada bit `scale` vezes na vertical (0b101, 2x -> 0b110011)
+static uint32_t scale_column(uint8_t column, uint8_t scale) {
+    uint32_t out = 0;
+    uint32_t unit = (1u << scale) - 1;
+    for (uint8_t bit = 0; bit < 7; bit++) {
+        if (column & (1 << bit)) {
+            out |= unit << (bit * scale);
+        }
+    }
+    return out;
+}
+
+static void build_tables() {
+    memset(s_digit_index, -1, sizeof(s_digit_index));
+    for (uint8_t i = 0; i < DIGITS_COUNT; i++) {
+        uint8_t c = (uint8_t)SSD1306_FONT_DIGITS_CHARSET[i];
+        const uint8_t *glyph = font5x7[c - FONT5X7_FIRST_CHAR];
+        s_digit_index[c] = i;
+        for (uint8_t col = 0; col < GLYPH5_COLS; col++) {
+            s_digits_2x[i][col] = scale_column(glyph[col], 2);
+            s_digits_3x[i][col] = scale_column(glyph[col], 3);
+        }
+    }
+    s_tables_ready = true;
+}
+
+uint8_t ssd1306_font_height(ssd1306_font_t font) {
+    switch (font) {
+        case SSD1306_FONT_5X7:       return 7;
+        case SSD1306_FONT_DIGITS_2X: return 14;
+        case SSD1306_FONT_DIGITS_3X: return 21;
+        case SSD1306_FONT_8X8:
+        default:                     return 8;
+    }
+}
+
+uint8_t ssd1306_font_advance(ssd1306_font_t font) {
+    switch (font) {
+        case SSD1306_FONT_5X7:       return GLYPH5_COLS + 1;
+        case SSD1306_FONT_DIGITS_2X: return (GLYPH5_COLS + 1) * 2;
+        case SSD1306_FONT_DIGITS_3X: return (GLYPH5_COLS + 1) * 3;
+        case SSD1306_FONT_8X8:
+        default:                     return 8;
+    }
+}
+
+uint16_t ssd1306_text_width(const char *text, ssd1306_font_t font) {
+    return (uint16_t)(strlen(text) * ssd1306_font_advance(font));
+}
+
+// 🧱 **Copia `count` colunas para o framebuffer, cada uma repetida `repeat` vezes**
+// Retorna a coluna seguinte (pode passar de OLED_WIDTH).
+static int blit_columns(uint8_t (*fb)[OLED_WIDTH], int x, uint8_t y, uint8_t height,
+                        const uint32_t *columns, uint8_t count, uint8_t repeat, uint8_t *dirty) {
+    uint8_t page = y >> 3;
+    uint8_t shift = y & 0x07;
+    uint8_t pages = (height + shift + 7) >> 3;
+    if (page + pages > OLED_PAGES) {
+        pages = OLED_PAGES - page;
+    }
+    uint32_t mask = ((1u << height) - 1) << shift;
+
+    // Marca as páginas antes: mesmo um glifo cortado na borda direita já escreveu colunas
+    if (x < OLED_WIDTH && count > 0 && repeat > 0) {
+        for (uint8_t p = 0; p < pages; p++) {
+            *dirty |= 1 << (page + p);
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t word = columns ? columns[i] << shift : 0;
+        for (uint8_t r = 0; r < repeat; r++, x++) {
+            if (x >= OLED_WIDTH) {
+                return x;
+            }
+            for (uint8_t p = 0; p < pages; p++) {
+                uint8_t m = (uint8_t)(mask >> (p * 8));
+                uint8_t v = (uint8_t)(word >> (p * 8));
+                fb[page + p][x] = (fb[page + p][x] & ~m) | v;
+            }
+        }
+    }
+    return x;
+}
+
+uint8_t ssd1306_draw_text(uint8_t x, uint8_t y, const char *text, ssd1306_font_t font) {
+    if (y >= OLED_HEIGHT) {
+        return x;
+    }
+    if (!s_tables_ready) {
+        build_tables();
+    }
+
+    uint8_t (*fb)[OLED_WIDTH] = ssd1306_fb_pages();
+    uint8_t height = ssd1306_font_height(font);
+    uint8_t dirty = 0;
+    int cx = x;
+    uint32_t columns[8];
+
+    for (const char *p = text; *p != '\0' && cx < OLED_WIDTH; p++) {
+        uint8_t c = (uint8_t)*p & 0x7F;
+
+        switch (font) {
+            case SSD1306_FONT_8X8:
+                for (uint8_t col = 0; col < 8; col++) {
+                    columns[col] = font8x8_basic_tr[c][col];
+                }
+                cx = blit_columns(fb, cx, y, height, columns, 8, 1, &dirty);
+                break;
+
+            case SSD1306_FONT_5X7: {
+                if (c < FONT5X7_FIRST_CHAR) {
+                    c = ' ';
+                }
+                const uint8_t *glyph = font5x7[c - FONT5X7_FIRST_CHAR];
+                for (uint8_t col = 0; col < GLYPH5_COLS; col++) {
+                    columns[col] = glyph[col];
+                }
+                cx = blit_columns(fb, cx, y, height, columns, GLYPH5_COLS, 1, &dirty);
+                cx = blit_columns(fb, cx, y, height, NULL, 1, 1, &dirty);
+                break;
+            }
+
+            case SSD1306_FONT_DIGITS_2X:
+            case SSD1306_FONT_DIGITS_3X: {
+                uint8_t scale = (font == SSD1306_FONT_DIGITS_2X) ? 2 : 3;
+                int8_t index = s_digit_index[c];
+                const uint32_t *glyph = NULL;
+                if (index >= 0) {
+                    glyph = (scale == 2) ? s_digits_2x[index] : s_digits_3x[index];
+                }
+                cx = blit_columns(fb, cx, y, height, glyph, GLYPH5_COLS, scale, &dirty);
+                cx = blit_columns(fb, cx, y, height, NULL, 1, scale, &dirty);
+                break;
+            }
+        }
+    }
+
+    ssd1306_fb_mark_dirty(dirty);
+    return (cx > OLED_WIDTH) ? OLED_WIDTH : (uint8_t)cx;
+}
@@ -0,0 +1,16 @@
+#ifndef SSD1306_PRIV_H
+#define SSD1306_PRIV_H
+
+// Acesso interno ao framebuffer para as outras partes do componente
+// (fontes, widgets). Não faz parte da API pública.
+
+#include <stdint.h>
+#include "ssd1306.h"
+
+// Páginas do framebuffer: fb[página][coluna]
+uint8_t (*ssd1306_fb_pages(void))[OLED_WIDTH];
+
+// Marca páginas como alteradas (bit N = página N)
+void ssd1306_fb_mark_dirty(uint8_t page_mask);
+
+#endif // SSD1306_PRIV_H
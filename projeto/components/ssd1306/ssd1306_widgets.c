@@ -0,0 +1,241 @@
+#include "ssd1306_widgets.h"
+#include <stdio.h>
+#include <string.h>
+
+// ----------------------
+// Leitura numérica
+// ----------------------
+
+void ssd1306_readout_init(ssd1306_readout_t *w, uint8_t x, uint8_t y, uint8_t width,
+                          ssd1306_font_t font, uint8_t decimals, const char *unit) {
+    memset(w, 0, sizeof(*w));
+    w->x = x;
+    w->y = y;
+    w->w = width;
+    w->font = font;
+    w->decimals = decimals;
+    w->unit = unit;
+}
+
+void ssd1306_readout_set_text(ssd1306_readout_t *w, const char *text) {
+    if (strncmp(w->shown, text, sizeof(w->shown)) == 0) {
+        return;  // Mesmo texto: nada a redesenhar
+    }
+    strncpy(w->shown, text, sizeof(w->shown) - 1);
+    w->shown[sizeof(w->shown) - 1] = '\0';
+
+    // Apaga só a caixa do widget e alinha o texto à direita
+    ssd1306_fill_rect(w->x, w->y, w->w, ssd1306_font_height(w->font), false);
+    uint16_t text_w = ssd1306_text_width(w->shown, w->font);
+    uint8_t x = (text_w < w->w) ? (uint8_t)(w->x + w->w - text_w) : w->x;
+    ssd1306_draw_text(x, w->y, w->shown, w->font);
+}
+
+void ssd1306_readout_set(ssd1306_readout_t *w, float value) {
+    char text[sizeof(w->shown)];
+    snprintf(text, sizeof(text), "%.*f%s", w->decimals, value, w->unit ? w->unit : "");
+    ssd1306_readout_set_text(w, text);
+}
+
+// ----------------------
+// Barra horizontal
+// Moldura de 1 px, 1 px de folga e o preenchimento por dentro. Ao mudar o
+// valor só as colunas entre o preenchimento antigo e o novo são tocadas.
+// ----------------------
+
+void ssd1306_hbar_init(ssd1306_hbar_t *bar, uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+    memset(bar, 0, sizeof(*bar));
+    bar->x = x;
+    bar->y = y;
+    bar->w = (w < 5) ? 5 : w;
+    bar->h = (h < 5) ? 5 : h;
+}
+
+void ssd1306_hbar_set(ssd1306_hbar_t *bar, uint8_t percent) {
+    if (percent > 100) {
+        percent = 100;
+    }
+
+    uint8_t inner_x = bar->x + 2;
+    uint8_t inner_y = bar->y + 2;
+    uint8_t inner_w = bar->w - 4;
+    uint8_t inner_h = bar->h - 4;
+
+    if (!bar->drawn) {
+        ssd1306_fill_rect(bar->x, bar->y, bar->w, bar->h, false);
+        ssd1306_fill_rect(bar->x, bar->y, bar->w, 1, true);
+        ssd1306_fill_rect(bar->x, bar->y + bar->h - 1, bar->w, 1, true);
+        ssd1306_fill_rect(bar->x, bar->y, 1, bar->h, true);
+        ssd1306_fill_rect(bar->x + bar->w - 1, bar->y, 1, bar->h, true);
+        bar->fill = 0;
+        bar->drawn = true;
+    }
+
+    uint8_t fill = (uint8_t)((inner_w * percent + 50) / 100);
+    if (fill > bar->fill) {
+        ssd1306_fill_rect(inner_x + bar->fill, inner_y, fill - bar->fill, inner_h, true);
+    } else if (fill < bar->fill) {
+        ssd1306_fill_rect(inner_x + fill, inner_y, bar->fill - fill, inner_h, false);
+    }
+    bar->fill = fill;
+}
+
+// ----------------------
+// Sparkline
+// ----------------------
+
+void ssd1306_sparkline_init(ssd1306_sparkline_t *sl, uint8_t x, uint8_t y, uint8_t w, uint8_t h,
+                            float min, float max) {
+    memset(sl, 0, sizeof(*sl));
+    sl->x = x;
+    sl->y = y;
+    // Pelo menos uma coluna (w indexa o ring buffer) e nada além da borda direita
+    if (w > SSD1306_SPARKLINE_MAX) w = SSD1306_SPARKLINE_MAX;
+    if (x < OLED_WIDTH && w > OLED_WIDTH - x) w = OLED_WIDTH - x;
+    sl->w = (w < 1) ? 1 : w;
+    sl->h = (h < 2) ? 2 : h;
+    sl->min = min;
+    sl->max = max;
+    sl->autoscale = (min == max);
+}
+
+// Linha da amostra dentro da caixa (0 = topo)
+static int sparkline_row(const ssd1306_sparkline_t *sl, float value, float min, float span) {
+    int row = (sl->h - 1) - (int)((value - min) * (sl->h - 1) / span + 0.5f);
+    if (row < 0) row = 0;
+    if (row > sl->h - 1) row = sl->h - 1;
+    return row;
+}
+
+void ssd1306_sparkline_push(ssd1306_sparkline_t *sl, float value) {
+    if (sl->w == 0) {
+        return;  // ssd1306_sparkline_init() ainda não foi chamado
+    }
+    sl->samples[sl->head] = value;
+    sl->head = (sl->head + 1) % sl->w;
+    if (sl->count < sl->w) {
+        sl->count++;
+    }
+
+    // Mais antiga primeiro; as amostras ficam encostadas à direita da caixa
+    uint8_t oldest = (sl->head + sl->w - sl->count) % sl->w;
+
+    float min = sl->min;
+    float max = sl->max;
+    if (sl->autoscale) {
+        min = max = sl->samples[oldest];
+        for (uint8_t i = 1; i < sl->count; i++) {
+            float v = sl->samples[(oldest + i) % sl->w];
+            if (v < min) min = v;
+            if (v > max) max = v;
+        }
+    }
+    float span = (max > min) ? (max - min) : 1.0f;
+
+    ssd1306_fill_rect(sl->x, sl->y, sl->w, sl->h, false);
+
+    // Um segmento vertical por coluna, ligando a amostra anterior à atual
+    uint8_t col = sl->x + sl->w - sl->count;
+    int prev = sparkline_row(sl, sl->samples[oldest], min, span);
+    for (uint8_t i = 0; i < sl->count; i++, col++) {
+        int row = sparkline_row(sl, sl->samples[(oldest + i) % sl->w], min, span);
+        int top = (row < prev) ? row : prev;
+        int bottom = (row < prev) ? prev : row;
+        ssd1306_fill_rect(col, sl->y + top, 1, bottom - top + 1, true);
+        prev = row;
+    }
+}
+
+// ----------------------
+// Indicador de inclinação
+// ----------------------
+
+void ssd1306_tilt_init(ssd1306_tilt_t *tilt, uint8_t cx, uint8_t cy, uint8_t r, float range_deg) {
+    memset(tilt, 0, sizeof(*tilt));
+    tilt->cx = cx;
+    tilt->cy = cy;
+    tilt->r = (r < 4) ? 4 : (r > OLED_HEIGHT / 2) ? OLED_HEIGHT / 2 : r;  // dot_x/dot_y são int8_t
+    tilt->range_deg = (range_deg > 0.0f) ? range_deg : 45.0f;
+}
+
+// O indicador pode passar das bordas da tela (centro perto da borda):
+// coordenadas negativas são cortadas aqui, antes de virarem uint8_t
+static void tilt_pixel(int x, int y) {
+    if (x >= 0 && y >= 0 && x < OLED_WIDTH && y < OLED_HEIGHT) {
+        ssd1306_draw_pixel(x, y, true);
+    }
+}
+
+static void tilt_fill_rect(int x, int y, int w, int h, bool on) {
+    if (x < 0) {
+        w += x;
+        x = 0;
+    }
+    if (y < 0) {
+        h += y;
+        y = 0;
+    }
+    if (w <= 0 || h <= 0 || x >= OLED_WIDTH || y >= OLED_HEIGHT) {
+        return;
+    }
+    ssd1306_fill_rect(x, y, (w > OLED_WIDTH) ? OLED_WIDTH : w, (h > OLED_HEIGHT) ? OLED_HEIGHT : h, on);
+}
+
+// Círculo de Bresenham (ponto médio)
+static void tilt_draw_circle(int cx, int cy, int r) {
+    int x = r;
+    int y = 0;
+    int err = 1 - r;
+    while (x >= y) {
+        tilt_pixel(cx + x, cy + y);
+        tilt_pixel(cx - x, cy + y);
+        tilt_pixel(cx + x, cy - y);
+        tilt_pixel(cx - x, cy - y);
+        tilt_pixel(cx + y, cy + x);
+        tilt_pixel(cx - y, cy + x);
+        tilt_pixel(cx + y, cy - x);
+        tilt_pixel(cx - y, cy - x);
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+void ssd1306_tilt_set(ssd1306_tilt_t *tilt, float roll_deg, float pitch_deg) {
+    // Limita o ponto (3x3) ao interior do círculo
+    int reach = tilt->r - 2;
+    float dx = roll_deg * reach / tilt->range_deg;
+    float dy = pitch_deg * reach / tilt->range_deg;
+    if (dx > reach) dx = reach;
+    if (dx < -reach) dx = -reach;
+    if (dy > reach) dy = reach;
+    if (dy < -reach) dy = -reach;
+
+    int8_t dot_x = (int8_t)(dx < 0 ? dx - 0.5f : dx + 0.5f);
+    int8_t dot_y = (int8_t)(dy < 0 ? dy - 0.5f : dy + 0.5f);
+    if (tilt->drawn && dot_x == tilt->dot_x && dot_y == tilt->dot_y) {
+        return;  // O ponto não mudou de pixel
+    }
+
+    int cx = tilt->cx;
+    int cy = tilt->cy;
+    int r = tilt->r;
+    tilt_fill_rect(cx - r, cy - r, 2 * r + 1, 2 * r + 1, false);
+    tilt_draw_circle(cx, cy, r);
+
+    // Cruz pontilhada marcando o nível
+    for (int i = -r + 2; i <= r - 2; i += 2) {
+        tilt_pixel(cx + i, cy);
+        tilt_pixel(cx, cy + i);
+    }
+
+    tilt_fill_rect(cx + dot_x - 1, cy + dot_y - 1, 3, 3, true);
+
+    tilt->dot_x = dot_x;
+    tilt->dot_y = dot_y;
+    tilt->drawn = true;
+}
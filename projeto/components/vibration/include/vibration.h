@@ -0,0 +1,61 @@
+#ifndef VIBRATION_H
+#define VIBRATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "vibration_fft.h"
+
+// ----------------------
+// Análise de vibração em fluxo
+// Recebe amostras de aceleração (3 eixos) uma a uma e, a cada `hop`
+// amostras, analisa as últimas `window`: RMS sem o nível DC (a gravidade
+// sai junto com a média), pico, fator de crista e frequência dominante via
+// FFT Q15. Em vez das amostras brutas, publica um vetor de features.
+// ----------------------
+
+#define VIBRATION_AXES 3
+#define VIBRATION_MAX_WINDOW VIBRATION_FFT_MAX_N
+
+// ⚙️ Configuração
+typedef struct {
+    uint16_t window;          // Amostras por janela: potência de 2, 8..512
+    uint16_t hop;             // Amostras entre janelas (window / 2 = 50 % de sobreposição)
+    uint16_t sample_rate_hz;  // Taxa das amostras recebidas
+    float scale;              // Unidade por contagem (ex.: g/LSB) aplicada às features
+} vibration_config_t;
+
+// 📦 Vetor de features de uma janela
+typedef struct {
+    uint32_t seq;                         // Número da janela
+    float rms[VIBRATION_AXES];            // RMS sem o nível DC
+    float peak[VIBRATION_AXES];           // Maior |x - média|
+    float crest[VIBRATION_AXES];          // pico / RMS (choques curtos => crista alta)
+    float dominant_hz[VIBRATION_AXES];    // Frequência do maior bin (sem DC), interpolada
+    float dominant_amp[VIBRATION_AXES];   // Amplitude estimada da senoide nesse bin
+    uint32_t cycles;                      // Ciclos de CPU gastos nesta janela
+} vibration_features_t;
+
+// 📊 Custo do processamento
+typedef struct {
+    uint32_t windows;
+    uint32_t last_cycles;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+} vibration_stats_t;
+
+typedef void (*vibration_callback_t)(const vibration_features_t *features, void *ctx);
+
+// 🔧 Configura a análise; callback é chamado no contexto de vibration_push()
+esp_err_t vibration_init(const vibration_config_t *config, vibration_callback_t callback, void *ctx);
+
+// 📥 Acrescenta uma amostra; retorna true quando uma janela foi analisada
+bool vibration_push(const int16_t accel[VIBRATION_AXES]);
+
+// 🔄 Esquece o histórico (ex.: depois de um buraco no fluxo de amostras)
+void vibration_reset();
+
+// 📊 Contadores de custo
+void vibration_get_stats(vibration_stats_t *stats);
+
+#endif // VIBRATION_H
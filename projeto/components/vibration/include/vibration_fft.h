@@ -0,0 +1,36 @@
+#ifndef VIBRATION_FFT_H
+#define VIBRATION_FFT_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+// ----------------------
+// FFT radix-2 em ponto fixo Q15
+// Sem ponto flutuante no laço: cada estágio divide por 2 para não saturar,
+// então a saída é X[k] / N. Tabelas de twiddle e janela de Hann são
+// calculadas uma única vez em vibration_fft_init().
+// ----------------------
+
+#define VIBRATION_FFT_MAX_N 512
+
+// Complexo Q15 intercalado (re, im)
+typedef struct {
+    int16_t re;
+    int16_t im;
+} vibration_cq15_t;
+
+// 🔧 Prepara twiddles e janela de Hann para N pontos (potência de 2, 8..512)
+esp_err_t vibration_fft_init(uint16_t n);
+
+// 🪟 Aplica a janela de Hann a n amostras reais e monta a entrada complexa
+void vibration_fft_window(const int16_t *in, vibration_cq15_t *out, uint16_t n);
+
+// 🌀 FFT in-place (N configurado em vibration_fft_init)
+void vibration_fft_run(vibration_cq15_t *data);
+
+// 📏 |X[k]|² de um bin (saída escalada por 1/N)
+static inline uint32_t vibration_fft_mag2(vibration_cq15_t x) {
+    return (uint32_t)((int32_t)x.re * x.re) + (uint32_t)((int32_t)x.im * x.im);
+}
+
+#endif // VIBRATION_FFT_H
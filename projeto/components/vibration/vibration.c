@@ -0,0 +1,146 @@
+#include "vibration.h"
+#include <math.h>
+#include <string.h>
+#include "esp_cpu.h"
+
+static vibration_config_t s_config;
+static vibration_callback_t s_callback = NULL;
+static void *s_callback_ctx = NULL;
+
+// Histórico circular por eixo com as últimas `window` amostras
+static int16_t s_history[VIBRATION_AXES][VIBRATION_MAX_WINDOW];
+static uint16_t s_head = 0;      // Próxima posição a escrever
+static uint16_t s_filled = 0;
+static uint16_t s_since_window = 0;
+
+// Áreas de trabalho da janela atual
+static int16_t s_centered[VIBRATION_MAX_WINDOW];
+static vibration_cq15_t s_spectrum[VIBRATION_MAX_WINDOW];
+
+static vibration_features_t s_features;
+static vibration_stats_t s_stats;
+
+esp_err_t vibration_init(const vibration_config_t *config, vibration_callback_t callback, void *ctx) {
+    if (config->hop == 0 || config->hop > config->window || config->sample_rate_hz == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = vibration_fft_init(config->window);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    s_config = *config;
+    s_callback = callback;
+    s_callback_ctx = ctx;
+    memset(&s_stats, 0, sizeof(s_stats));
+    memset(&s_features, 0, sizeof(s_features));
+    vibration_reset();
+    return ESP_OK;
+}
+
+void vibration_reset() {
+    s_head = 0;
+    s_filled = 0;
+    s_since_window = 0;
+}
+
+// 🔎 Analisa um eixo: momentos no domínio do tempo e bin dominante da FFT
+static void vibration_analyze_axis(int axis) {
+    uint16_t n = s_config.window;
+    const int16_t *hist = s_history[axis];
+
+    // Desenrola o histórico (mais antiga primeiro) e tira a média
+    int32_t sum = 0;
+    for (uint16_t i = 0, idx = s_head; i < n; i++) {
+        sum += hist[idx];
+        idx = (idx + 1 == n) ? 0 : idx + 1;
+    }
+    int32_t mean = sum / n;
+
+    uint64_t sum_sq = 0;
+    int32_t peak = 0;
+    for (uint16_t i = 0, idx = s_head; i < n; i++) {
+        int32_t x = hist[idx] - mean;
+        idx = (idx + 1 == n) ? 0 : idx + 1;
+        if (x > INT16_MAX) x = INT16_MAX;
+        if (x < -INT16_MAX) x = -INT16_MAX;
+        s_centered[i] = (int16_t)x;
+        sum_sq += (uint64_t)((int64_t)x * x);
+        int32_t mag = (x < 0) ? -x : x;
+        if (mag > peak) peak = mag;
+    }
+
+    float rms = sqrtf((float)sum_sq / n);
+    s_features.rms[axis] = rms * s_config.scale;
+    s_features.peak[axis] = peak * s_config.scale;
+    s_features.crest[axis] = (rms > 0.0f) ? peak / rms : 0.0f;
+
+    vibration_fft_window(s_centered, s_spectrum, n);
+    vibration_fft_run(s_spectrum);
+
+    // Maior bin de 1 a N/2 - 1 (o DC já saiu com a média)
+    uint16_t best = 1;
+    uint32_t best_mag2 = 0;
+    for (uint16_t k = 1; k < n / 2; k++) {
+        uint32_t mag2 = vibration_fft_mag2(s_spectrum[k]);
+        if (mag2 > best_mag2) {
+            best_mag2 = mag2;
+            best = k;
+        }
+    }
+
+    // Interpolação parabólica entre os vizinhos para sair da grade de bins
+    float m0 = sqrtf((float)vibration_fft_mag2(s_spectrum[best - 1]));
+    float m1 = sqrtf((float)best_mag2);
+    float m2 = sqrtf((float)vibration_fft_mag2(s_spectrum[best + 1]));
+    float denom = m0 - 2.0f * m1 + m2;
+    float delta = (denom != 0.0f) ? 0.5f * (m0 - m2) / denom : 0.0f;
+
+    s_features.dominant_hz[axis] = (best + delta) * s_config.sample_rate_hz / n;
+    // Saída escalada por 1/N e ganho coerente 0,5 da Hann: A = 4 |X[k]/N|
+    s_features.dominant_amp[axis] = 4.0f * m1 * s_config.scale;
+}
+
+bool vibration_push(const int16_t accel[VIBRATION_AXES]) {
+    uint16_t n = s_config.window;
+    if (n == 0) {
+        return false;  // vibration_init() ainda não foi chamado
+    }
+
+    for (int axis = 0; axis < VIBRATION_AXES; axis++) {
+        s_history[axis][s_head] = accel[axis];
+    }
+    s_head = (s_head + 1 == n) ? 0 : s_head + 1;
+    if (s_filled < n) {
+        s_filled++;
+    }
+    s_since_window++;
+
+    if (s_filled < n || s_since_window < s_config.hop) {
+        return false;
+    }
+    s_since_window = 0;
+
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (int axis = 0; axis < VIBRATION_AXES; axis++) {
+        vibration_analyze_axis(axis);
+    }
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+
+    s_features.seq = s_stats.windows++;
+    s_features.cycles = cycles;
+    s_stats.last_cycles = cycles;
+    s_stats.total_cycles += cycles;
+    if (cycles > s_stats.max_cycles) {
+        s_stats.max_cycles = cycles;
+    }
+
+    if (s_callback) {
+        s_callback(&s_features, s_callback_ctx);
+    }
+    return true;
+}
+
+void vibration_get_stats(vibration_stats_t *stats) {
+    *stats = s_stats;
+}
@@ -0,0 +1,75 @@
+#include "vibration_fft.h"
+#include <math.h>
+
+static int16_t s_cos[VIBRATION_FFT_MAX_N / 2];
+static int16_t s_sin[VIBRATION_FFT_MAX_N / 2];
+static int16_t s_hann[VIBRATION_FFT_MAX_N];
+static uint16_t s_n = 0;
+
+esp_err_t vibration_fft_init(uint16_t n) {
+    if (n < 8 || n > VIBRATION_FFT_MAX_N || (n & (n - 1)) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Só aqui usamos float: as tabelas são calculadas uma vez por tamanho
+    for (uint16_t k = 0; k < n / 2; k++) {
+        float angle = 2.0f * (float)M_PI * k / n;
+        s_cos[k] = (int16_t)lrintf(cosf(angle) * 32767.0f);
+        s_sin[k] = (int16_t)lrintf(sinf(angle) * 32767.0f);
+    }
+    // Hann periódica: a janela se repete sem descontinuidade entre hops
+    for (uint16_t i = 0; i < n; i++) {
+        s_hann[i] = (int16_t)lrintf(0.5f * (1.0f - cosf(2.0f * (float)M_PI * i / n)) * 32767.0f);
+    }
+    s_n = n;
+    return ESP_OK;
+}
+
+void vibration_fft_window(const int16_t *in, vibration_cq15_t *out, uint16_t n) {
+    for (uint16_t i = 0; i < n; i++) {
+        out[i].re = (int16_t)(((int32_t)in[i] * s_hann[i]) >> 15);
+        out[i].im = 0;
+    }
+}
+
+void vibration_fft_run(vibration_cq15_t *data) {
+    uint16_t n = s_n;
+
+    // Permutação por bit reverso
+    for (uint16_t i = 1, j = 0; i < n; i++) {
+        uint16_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            vibration_cq15_t tmp = data[i];
+            data[i] = data[j];
+            data[j] = tmp;
+        }
+    }
+
+    // Borboletas DIT; >> 1 por estágio mantém o módulo dentro de Q15
+    for (uint16_t len = 2; len <= n; len <<= 1) {
+        uint16_t half = len >> 1;
+        uint16_t step = n / len;
+        for (uint16_t i = 0; i < n; i += len) {
+            for (uint16_t j = 0; j < half; j++) {
+                int32_t wr = s_cos[j * step];
+                int32_t wi = -s_sin[j * step];  // e^(-j2πk/N)
+                vibration_cq15_t *a = &data[i + j];
+                vibration_cq15_t *b = &data[i + j + half];
+
+                int32_t tr = ((int32_t)b->re * wr - (int32_t)b->im * wi) >> 15;
+                int32_t ti = ((int32_t)b->re * wi + (int32_t)b->im * wr) >> 15;
+                int32_t ar = a->re;
+                int32_t ai = a->im;
+
+                a->re = (int16_t)((ar + tr) >> 1);
+                a->im = (int16_t)((ai + ti) >> 1);
+                b->re = (int16_t)((ar - tr) >> 1);
+                b->im = (int16_t)((ai - ti) >> 1);
+            }
+        }
+    }
+}
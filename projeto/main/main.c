@@ -4,29 +4,59 @@
 #include "freertos/queue.h"
 #include "driver/gpio.h"
 #include "esp_log.h"
-#include "driver/i2c.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
 
 #include "owb.h"
 #include "owb_gpio.h"
+#include "owb_uart.h"
 #include "ds18b20.h"
+#include "ds18b20_group.h"
+#include "ds18b20_sched.h"
+#include "ds18b20_adaptive.h"
 #include "ssd1306.h"
+#include "ssd1306_font.h"
+#include "ssd1306_widgets.h"
 #include "ssr.h"
 #include "mpu6050.h"
+#include "vibration.h"
+#include "nvs_flash.h"
 
 static const char *TAG = "APP_MAIN";
 
 // GPIO do sensor de temperatura DS18B20
 #define ONE_WIRE_PIN  (12)
+// 1: slots gerados pela UART1 (CPU livre, interrupções ligadas);
+// 0: bit-banging por GPIO
+#define ONE_WIRE_USE_UART 1
+#define ONE_WIRE_UART UART_NUM_1
+#define ONE_WIRE_BENCHMARK_ROUNDS 20  // GPIO: leituras por caminho na comparação de latência
+// 1: acessa em overdrive (~10x mais rápido) os dispositivos que suportam; os
+// demais ficam na velocidade padrão. O DS18B20 não tem overdrive, então com
+// só DS18B20 no barramento isso apenas custa uma sondagem por sensor no início.
+#define ONE_WIRE_USE_OVERDRIVE 0
+#define ONE_WIRE_NVS_NAMESPACE "owb_roms"  // ROMs das sondas conhecidas, para o boot sem busca completa
 
 // Definições do LED e Botão
 #define BUTTON_PIN GPIO_NUM_11  // Pino do botão
 #define LED_PIN GPIO_NUM_9      // Pino do LED (ou SSR)
 #define TEMPERATURE_THRESHOLD 28.5  // Temperatura limite para acionar o LED
-
-// I2C para MPU6050
-#define I2C_MASTER_SDA 17
-#define I2C_MASTER_SCL 18
-#define I2C_MASTER_NUM I2C_NUM_0
+#define TEMPERATURE_CONTROL_SENSOR 0  // Índice no grupo (ordem da busca; fixo após hot-plug) do sensor que comanda o SSR
+#define TEMPERATURE_FULL_READ_EVERY 10  // Leituras rápidas (2 bytes) entre duas completas com CRC
+#define TEMPERATURE_MAX_RATE_C_S 2.0f   // Variação plausível entre leituras (°C/s)
+// Resolução adaptativa: 12 bits a menos de 0,5 °C do limite, 11 até 1,5 °C,
+// 10 até 3 °C e 9 bits (~10 Hz) além disso
+#define TEMPERATURE_BAND_12BIT_C 0.5f
+#define TEMPERATURE_BAND_11BIT_C 1.5f
+#define TEMPERATURE_BAND_10BIT_C 3.0f
+#define TEMPERATURE_HYSTERESIS_C 0.25f
+#define TEMPERATURE_HORIZON_S 5.0f      // Aproximação rápida do limite já conta como "perto"
+#define TEMPERATURE_HISTORY_MS 2000     // Um ponto do gráfico do painel a cada 2 s
+// Limites de alarme das outras sondas (TH/TL do DS18B20, °C inteiros). O
+// sensor compara só a parte inteira, então TH = parte inteira do limite
+// pega tudo que pode passar dele; TL no mínimo do registrador fica desligado.
+#define TEMPERATURE_ALARM_HIGH_C ((int8_t)TEMPERATURE_THRESHOLD)
+#define TEMPERATURE_ALARM_LOW_C INT8_MIN
 
 // Controle do LED via botão
 typedef enum {
@@ -38,70 +68,282 @@ static volatile int led_on = 0;
 static volatile int led_intensity = 0;
 static ssr_t ssr;
 
+// Últimos valores publicados pelas tasks de sensores para o painel
+static volatile float dash_temp_c = 0.0f;
+static volatile bool dash_temp_ok = false;
+static volatile uint32_t dash_temp_seq = 0;  // Incrementa a cada leitura nova
+static volatile float dash_roll = 0.0f;
+static volatile float dash_pitch = 0.0f;
+
+#define DASHBOARD_PERIOD_MS 100  // 10 FPS
+// Medição de glifos/s no alvo antes do primeiro quadro: desligada em produção
+// (o bench_font de test/host cobre o dia a dia). Para medir, compile com
+// -DDASHBOARD_FONT_BENCHMARK_ROUNDS=200 (textos por fonte).
+#ifndef DASHBOARD_FONT_BENCHMARK_ROUNDS
+#define DASHBOARD_FONT_BENCHMARK_ROUNDS 0
+#endif
+
 // MPU6050
 #define MAX_ERROS 3  
+#define MPU_SAMPLE_RATE_HZ 1000
+#define MPU_DRAIN_PERIOD_MS 40   // FIFO enche em ~85 ms a 1 kHz
+#define MPU_BATCH_SAMPLES 128
+#define MPU_CALIB_MS 80          // Calibração: ~80 amostras, cabe na FIFO sem estourar
+#define MPU_ACCEL_FS MPU6050_ACCEL_FS_4G
+#define MPU_GYRO_FS MPU6050_GYRO_FS_250DPS
+#define MAHONY_KP 2.0f
+#define MAHONY_KI 0.01f
+#define MPU_MOTION_THRESHOLD 20  // x 2 mg = 40 mg acima do repouso
+#define MPU_ACTIVE_HOLD_MS 2000  // Continua lendo a FIFO até 2 s após o último movimento
+#define MPU_IDLE_CHECK_MS 5000   // Em repouso, confere a saúde do sensor a cada 5 s
+
+// Análise de vibração (features em m/s²)
+#define VIB_WINDOW 256           // 256 ms a 1 kHz, resolução de ~3,9 Hz
+#define VIB_HOP 128              // 50 % de sobreposição: uma janela a cada 128 ms
+#define VIB_RMS_LIMIT_MPS2 0.5f  // Vibração sustentada (~0,05 g)
+#define VIB_PEAK_LIMIT_MPS2 5.0f // Choque curto (~0,5 g)
 TaskHandle_t mpuTaskHandle = NULL;
 
+// Calibração, conversão para SI e orientação do MPU6050 (usadas só pela mpu_task)
+static mpu6050_calib_t mpu_calib;
+static mpu6050_scaler_t mpu_scaler;
+static mpu6050_mahony_t orientation;
+
 void mpu_task(void *pvParameter);
 
 
-// Função para reiniciar o sistema caso o MPU6050 falhe
+// Função para recuperar o MPU6050 caso ele falhe.
+// Chamada pela própria mpu_task; só retorna quando o sensor voltar.
+// O barramento continua instalado: os outros dispositivos não são afetados.
 void reset_system()
 {
-    ESP_LOGW(TAG, "🔄 Reiniciando MPU6050 e I2C...");
+    ESP_LOGW(TAG, "🔄 Recuperando MPU6050...");
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(500));
+
+        if (mpu6050_bus_recover() == ESP_OK && mpu6050_init() == ESP_OK) {
+            i2c_bus_stats_t stats;
+            mpu6050_get_bus_stats(&stats);
+            ESP_LOGI(TAG, "✅ MPU6050 recuperado (%lu transações, %lu erros, %lu timeouts)",
+                     (unsigned long)stats.transactions, (unsigned long)stats.errors,
+                     (unsigned long)stats.timeouts);
+            return;
+        }
+        ESP_LOGE(TAG, "⚠️ Erro ao reinicializar MPU6050! Tentando novamente...");
+        vTaskDelay(pdMS_TO_TICKS(5000));
+    }
+}
+
+// Recebe as features de cada janela de vibração (contexto da mpu_task)
+static void vibration_handler(const vibration_features_t *f, void *ctx)
+{
+    bool sustentada = false;
+    bool choque = false;
+    for (int axis = 0; axis < VIBRATION_AXES; axis++) {
+        sustentada |= f->rms[axis] > VIB_RMS_LIMIT_MPS2;
+        choque |= f->peak[axis] > VIB_PEAK_LIMIT_MPS2;
+    }
 
-    if (mpuTaskHandle != NULL) {
-        vTaskDelete(mpuTaskHandle);
-        mpuTaskHandle = NULL;
-        ESP_LOGI(TAG, "✅ Task mpu_task deletada!");
+    if (sustentada || choque) {
+        led_on = 1;
+        led_intensity = 100;
+        ssr_set_duty(&ssr, led_intensity);
+        ESP_LOGW(TAG, "⚠️ Vibração %s! RMS %.2f/%.2f/%.2f m/s², pico %.2f/%.2f/%.2f m/s², dominante %.1f/%.1f/%.1f Hz",
+                 choque ? "(choque)" : "sustentada",
+                 f->rms[0], f->rms[1], f->rms[2], f->peak[0], f->peak[1], f->peak[2],
+                 f->dominant_hz[0], f->dominant_hz[1], f->dominant_hz[2]);
     }
+}
+
+// Configura a análise de vibração com a escala atual (m/s² por LSB)
+static void configurar_vibracao()
+{
+    const vibration_config_t vib_config = {
+        .window = VIB_WINDOW,
+        .hop = VIB_HOP,
+        .sample_rate_hz = MPU_SAMPLE_RATE_HZ,
+        .scale = mpu6050_scaler_accel_mps2_per_lsb(&mpu_scaler),
+    };
+    vibration_init(&vib_config, vibration_handler, NULL);
+}
+
+// Aplica uma calibração: conversão SI, bias do filtro e escala da vibração
+static void aplicar_calibracao(const mpu6050_calib_t *calib)
+{
+    mpu6050_scaler_init(&mpu_scaler, calib, MPU_ACCEL_FS, MPU_GYRO_FS);
+    if (calib != NULL) {
+        mpu6050_mahony_set_bias(&orientation, calib->gyro_offset);
+    }
+    configurar_vibracao();
+}
 
-    i2c_driver_delete(I2C_MASTER_NUM);
-    vTaskDelay(pdMS_TO_TICKS(500));
+// Calibra com o sensor parado: descarta a FIFO, junta ~MPU_CALIB_MS de
+// amostras e, se não houve movimento, aplica e grava em NVS
+static bool calibrar_sensor(mpu6050_sample_t *buffer, size_t max)
+{
+    bool ok = false;
+    mpu6050_fifo_flush();
+    vTaskDelay(pdMS_TO_TICKS(MPU_CALIB_MS));
+    if (mpu6050_fifo_drain() > 0) {
+        size_t n = mpu6050_fifo_pop(buffer, max);
+        ok = mpu6050_calib_compute(buffer, n, MPU_ACCEL_FS, MPU_GYRO_FS, &mpu_calib);
+        if (ok) {
+            aplicar_calibracao(&mpu_calib);
+        }
+        for (size_t i = 0; i < n; i++) {
+            mpu6050_mahony_update(&orientation, &buffer[i]);
+        }
+    }
 
-    if (i2c_master_init() == ESP_OK && mpu6050_init() == ESP_OK) {
-        ESP_LOGI(TAG, "✅ MPU6050 e I2C reinicializados com sucesso!");
-        xTaskCreate(mpu_task, "mpu_task", 4096, NULL, 5, &mpuTaskHandle);
+    if (ok) {
+        ESP_LOGI(TAG, "✅ Calibração: accel offset %d/%d/%d LSB, ganho %.4f | gyro offset %d/%d/%d LSB",
+                 mpu_calib.accel_offset[0], mpu_calib.accel_offset[1], mpu_calib.accel_offset[2],
+                 mpu_calib.accel_gain, mpu_calib.gyro_offset[0], mpu_calib.gyro_offset[1], mpu_calib.gyro_offset[2]);
+        if (mpu6050_calib_save(&mpu_calib) != ESP_OK) {
+            ESP_LOGW(TAG, "⚠️ Não foi possível gravar a calibração em NVS");
+        }
     } else {
-        ESP_LOGE(TAG, "⚠️ Erro ao reinicializar MPU6050! Tentando novamente...");
-        vTaskDelay(pdMS_TO_TICKS(5000));
-        reset_system();
+        ESP_LOGW(TAG, "⚠️ Sensor em movimento; calibração adiada");
     }
+    return ok;
 }
 
 // Task para ler dados do MPU6050 e detectar vibração
+// A task dorme até o MPU6050 sinalizar movimento pelo pino INT. A partir
+// daí esvazia a FIFO (1 kHz) em rajadas enquanto houver atividade e volta
+// a dormir MPU_ACTIVE_HOLD_MS depois do último evento de movimento.
 void mpu_task(void *pvParameter)
 {
-    mpu6050_data_t sensor_data;
+    static mpu6050_sample_t samples[MPU_BATCH_SAMPLES];
+    mpu6050_si_sample_t ultimo_si = {0};
+    float roll = 0.0f;
+    float pitch = 0.0f;
+    bool calibrado = false;
     int falha_count = 0;
+    bool sensor_pronto = false;
+    bool ativo = false;
+    TickType_t ultimo_movimento = 0;
+
+    const mpu6050_fifo_config_t fifo_config = {
+        .sample_rate_hz = MPU_SAMPLE_RATE_HZ,
+        .dlpf_cfg = 1,  // ~184 Hz de banda: mantém o conteúdo de vibração
+    };
+    const mpu6050_int_config_t int_config = {
+        .gpio = MPU6050_INT_GPIO,
+        .enable_mask = MPU6050_INT_MOTION,
+        .motion_threshold = MPU_MOTION_THRESHOLD,
+        .motion_duration_ms = 1,
+        .notify_task = xTaskGetCurrentTaskHandle(),
+    };
+
+    mpu6050_mahony_init(&orientation, MPU_SAMPLE_RATE_HZ, MAHONY_KP, MAHONY_KI, MPU_GYRO_FS);
+
+    // Calibração salva vale se foi feita nas mesmas faixas de medida
+    calibrado = mpu6050_calib_load(&mpu_calib) == ESP_OK &&
+                mpu_calib.accel_fs == MPU_ACCEL_FS && mpu_calib.gyro_fs == MPU_GYRO_FS;
+    aplicar_calibracao(calibrado ? &mpu_calib : NULL);
+    if (calibrado) {
+        ESP_LOGI(TAG, "✅ Calibração do MPU6050 carregada da NVS");
+    }
+
+    if (i2c_master_init() != ESP_OK || mpu6050_init() != ESP_OK) {
+        falha_count = MAX_ERROS;
+    }
 
     while (1)
     {
-        if (mpu6050_read_data(&sensor_data) == ESP_OK) {
-            calculate_euler_angles(&sensor_data);
-            ESP_LOGI(TAG, "Accel: X=%d, Y=%d, Z=%d | Roll: %.2f° | Pitch: %.2f°",
-                     sensor_data.accel_x, sensor_data.accel_y, sensor_data.accel_z,
-                     sensor_data.roll, sensor_data.pitch);
+        if (falha_count >= MAX_ERROS) {
+            reset_system();
+            falha_count = 0;
+            sensor_pronto = false;
+        }
 
-            falha_count = 0;  
+        if (!sensor_pronto) {
+            if (mpu6050_set_full_scale(MPU_ACCEL_FS, MPU_GYRO_FS) != ESP_OK ||
+                mpu6050_fifo_start(&fifo_config) != ESP_OK || mpu6050_int_start(&int_config) != ESP_OK) {
+                ESP_LOGE(TAG, "❌ Falha ao configurar FIFO/INT do MPU6050");
+                falha_count++;
+                vTaskDelay(pdMS_TO_TICKS(MPU_DRAIN_PERIOD_MS));
+                continue;
+            }
+            sensor_pronto = true;
+            ativo = false;
 
-            // Se houver uma vibração detectável, acende o LED
-            if (abs(sensor_data.accel_x) > 3000 || abs(sensor_data.accel_y) > 3000 || abs(sensor_data.accel_z) > 3000) {
-                led_on = 1;
-                led_intensity = 100;
-                ssr_set_duty(&ssr, led_intensity);
-                ESP_LOGW(TAG, "⚠️ Vibração detectada! LED ACESO!");
+            if (!calibrado) {
+                calibrado = calibrar_sensor(samples, MPU_BATCH_SAMPLES);
             }
+        }
 
-        } else {
+        // Ativo: acorda a cada período de dreno. Em repouso: só movimento
+        // (ou o timeout longo, usado para conferir que o sensor responde).
+        uint8_t status = 0;
+        TickType_t espera = pdMS_TO_TICKS(ativo ? MPU_DRAIN_PERIOD_MS : MPU_IDLE_CHECK_MS);
+        esp_err_t err = mpu6050_int_wait(espera, &status);
+
+        if (err == ESP_OK && (status & MPU6050_INT_MOTION)) {
+            if (!ativo) {
+                // A FIFO encheu (e estourou) durante o repouso: começa do zero
+                mpu6050_fifo_flush();
+                vibration_reset();
+                ativo = true;
+            }
+            ultimo_movimento = xTaskGetTickCount();
+        } else if (err != ESP_OK && err != ESP_ERR_TIMEOUT) {
+            ESP_LOGE(TAG, "❌ Falha ao ler INT_STATUS do MPU6050");
+            falha_count++;
+            continue;
+        }
+
+        if (!ativo) {
+            // Timeout em repouso: confere se o sensor ainda responde e, se
+            // a calibração falhou por movimento no boot, tenta de novo
+            uint8_t who_am_i;
+            if (err == ESP_ERR_TIMEOUT && mpu6050_read_registers(MPU6050_REG_WHO_AM_I, &who_am_i, 1) != ESP_OK) {
+                ESP_LOGE(TAG, "❌ MPU6050 não responde");
+                falha_count++;
+            } else if (err == ESP_ERR_TIMEOUT && !calibrado) {
+                calibrado = calibrar_sensor(samples, MPU_BATCH_SAMPLES);
+            }
+            continue;
+        }
+
+        if (mpu6050_fifo_drain() < 0) {
             ESP_LOGE(TAG, "❌ Falha ao ler MPU6050");
             falha_count++;
+            continue;
+        }
+        falha_count = 0;
 
-            if (falha_count >= MAX_ERROS) {
-                reset_system(); 
+        size_t n;
+        while ((n = mpu6050_fifo_pop(samples, MPU_BATCH_SAMPLES)) > 0) {
+            for (size_t i = 0; i < n; i++) {
+                vibration_push(samples[i].accel);
+                mpu6050_mahony_update(&orientation, &samples[i]);
             }
+            mpu6050_scaler_apply(&mpu_scaler, &samples[n - 1], &ultimo_si, 1);
+        }
+        mpu6050_mahony_get_euler(&orientation, &roll, &pitch, NULL);
+        dash_roll = roll;
+        dash_pitch = pitch;
+
+        if (xTaskGetTickCount() - ultimo_movimento >= pdMS_TO_TICKS(MPU_ACTIVE_HOLD_MS)) {
+            ativo = false;
+
+            mpu6050_fifo_stats_t fifo_stats;
+            mpu6050_int_stats_t int_stats;
+            vibration_stats_t vib_stats;
+            mpu6050_fifo_get_stats(&fifo_stats);
+            mpu6050_int_get_stats(&int_stats);
+            vibration_get_stats(&vib_stats);
+            ESP_LOGI(TAG, "Repouso | Accel: %.2f/%.2f/%.2f m/s² | Roll: %.2f° | Pitch: %.2f° | %lu amostras, %lu eventos, latência máx %lu us",
+                     MPU6050_MILLI_TO_SI(ultimo_si.accel_mms2[0]), MPU6050_MILLI_TO_SI(ultimo_si.accel_mms2[1]),
+                     MPU6050_MILLI_TO_SI(ultimo_si.accel_mms2[2]), roll, pitch, (unsigned long)fifo_stats.samples,
+                     (unsigned long)int_stats.motion_events, (unsigned long)int_stats.max_latency_us);
+            ESP_LOGI(TAG, "Análise: %lu janelas, %lu ciclos/janela (máx %lu)",
+                     (unsigned long)vib_stats.windows, (unsigned long)vib_stats.last_cycles,
+                     (unsigned long)vib_stats.max_cycles);
         }
-        vTaskDelay(pdMS_TO_TICKS(1000));
     }
 }
 
@@ -131,56 +373,243 @@ void button_task(void *arg) {
     }
 }
 
-// Task para leitura da temperatura e controle do LED
+#if !ONE_WIRE_USE_UART
+// Compara o pior tempo com interrupções desligadas dos dois caminhos do
+// driver GPIO (legado x rápido) lendo o scratchpad de todos os sensores
+static void owb_gpio_benchmark(owb_gpio_driver_info *driver, ds18b20_group_t *sensores) {
+    for (int fast = 0; fast <= 1; fast++) {
+        owb_gpio_use_fast_path(driver, fast);
+        owb_gpio_reset_stats(driver);
+        for (int r = 0; r < ONE_WIRE_BENCHMARK_ROUNDS; r++) {
+            for (size_t i = 0; i < sensores->count; i++) {
+                float t;
+                ds18b20_read_temp(&sensores->sensors[i], &t);
+            }
+        }
+        owb_gpio_stats_t stats;
+        owb_gpio_get_stats(driver, &stats);
+        ESP_LOGI(TAG, "1-Wire GPIO %s: pior %lu us com interrupções desligadas (%lu seções, %llu us no total)",
+                 fast ? "rápido" : "legado", (unsigned long)stats.max_critical_us,
+                 (unsigned long)stats.critical_sections, (unsigned long long)stats.total_critical_us);
+    }
+}
+#endif
+
 // Task para leitura da temperatura e controle do LED
 void temperature_task(void *arg) {
-    ssd1306_init();
-
-    owb_gpio_driver_info driver;
+#if ONE_WIRE_USE_UART
+    static owb_uart_driver_info driver;
+    OneWireBus *owb = owb_uart_initialize(&driver, ONE_WIRE_UART, ONE_WIRE_PIN);
+#else
+    static owb_gpio_driver_info driver;
     OneWireBus *owb = owb_gpio_initialize(&driver, ONE_WIRE_PIN);
+#endif
     owb_use_parasitic_power(owb, false);
+    if (ONE_WIRE_USE_OVERDRIVE && owb_use_overdrive(owb, true) != OWB_STATUS_OK) {
+        ESP_LOGW(TAG, "Driver 1-Wire sem overdrive; só velocidade padrão");
+    }
 
-    DS18B20_Info *ds18b20_info = ds18b20_malloc();
-    ds18b20_init_solo(ds18b20_info, owb);
-    ds18b20_use_crc(ds18b20_info, true);
-    ds18b20_set_resolution(ds18b20_info, DS18B20_RESOLUTION_12_BIT);
+    // Todas as sondas do barramento (aquecedor, ambiente, dissipador...).
+    // As ROMs ficam na NVS: no boot só cada sonda conhecida é verificada, e a
+    // busca completa fica para a primeira vez ou para sondas recolocadas.
+    static owb_registry_t roms;
+    owb_registry_init(&roms, owb, ONE_WIRE_NVS_NAMESPACE);
+    static ds18b20_group_t sensores;
+    size_t n = ds18b20_group_init_cached(&sensores, &roms);
+    if (n == 0) {
+        ESP_LOGE(TAG, "❌ Nenhum DS18B20 encontrado no barramento");
+    }
+    ds18b20_group_use_crc(&sensores, true);
+#if !ONE_WIRE_USE_UART
+    owb_gpio_benchmark(&driver, &sensores);
+#endif
+    ds18b20_group_use_fast_read(&sensores, TEMPERATURE_FULL_READ_EVERY, TEMPERATURE_MAX_RATE_C_S);
+    ds18b20_group_set_resolution(&sensores, DS18B20_RESOLUTION_12_BIT);
+
+    // As demais sondas só interessam quando esquentam: a cada ciclo uma
+    // ALARM SEARCH, e só quem disparou é lido. O sensor de controle é lido sempre.
+    ds18b20_group_set_always_read(&sensores, TEMPERATURE_CONTROL_SENSOR, true);
+    if (!ds18b20_group_use_alarm(&sensores, TEMPERATURE_ALARM_HIGH_C, TEMPERATURE_ALARM_LOW_C)) {
+        ESP_LOGW(TAG, "Modo alarme indisponível; lendo todas as sondas");
+    }
 
-    char temp_text[32];
+    // Precisão só perto do limite de controle; longe dele, amostragem rápida
+    static ds18b20_adaptive_t adaptativo;
+    const ds18b20_adaptive_config_t adaptive_config = {
+        .setpoint_c = TEMPERATURE_THRESHOLD,
+        .band_c = {TEMPERATURE_BAND_12BIT_C, TEMPERATURE_BAND_11BIT_C, TEMPERATURE_BAND_10BIT_C},
+        .hysteresis_c = TEMPERATURE_HYSTERESIS_C,
+        .horizon_s = TEMPERATURE_HORIZON_S,
+        .rate_alpha = 0.3f,
+    };
+    ds18b20_adaptive_init(&adaptativo, &adaptive_config);
+    DS18B20_RESOLUTION resolucao = adaptativo.resolution;
+
+    // Conversão agendada fora desta task: aqui só chega a leitura pronta.
+    // Uma conversão broadcast por varredura; sensores com alimentação
+    // externa, então o fim dela é sondado pelos read slots em vez de
+    // esperar sempre os 750 ms do datasheet.
+    QueueHandle_t readings = xQueueCreate(2 * DS18B20_GROUP_MAX, sizeof(ds18b20_reading_t));
+    const ds18b20_sched_config_t sched_config = {
+        .period_ms = ds18b20_adaptive_period_ms(resolucao),
+        .wait_mode = DS18B20_WAIT_POLL,
+        .queue = readings,
+        .task_priority = 10,
+    };
+    if (readings == NULL || ds18b20_sched_start_group(&sensores, &sched_config) != ESP_OK) {
+        ESP_LOGE(TAG, "❌ Falha ao iniciar o agendador do DS18B20");
+        vTaskDelete(NULL);
+    }
 
     while (1) {
-        float temp_c = 0.0f;
-        DS18B20_ERROR err = ds18b20_convert_and_read_temp(ds18b20_info, &temp_c);
+        ds18b20_reading_t reading;
+        xQueueReceive(readings, &reading, portMAX_DELAY);
+        float temp_c = reading.temperature;
+        DS18B20_ERROR err = reading.error;
+
+        if (reading.index != TEMPERATURE_CONTROL_SENSOR) {
+            if (err == DS18B20_OK && reading.alarm) {
+                ESP_LOGW(TAG, "Sensor %u em alarme: %.2f °C", reading.index, temp_c);
+            } else if (err == DS18B20_OK) {
+                ESP_LOGI(TAG, "Sensor %u: %.2f °C", reading.index, temp_c);
+            } else {
+                ESP_LOGE(TAG, "Erro ao ler o sensor %u", reading.index);
+            }
+            continue;
+        }
 
         if (err == DS18B20_OK) {
-            ESP_LOGI(TAG, "Temperatura: %.2f °C", temp_c);
-            snprintf(temp_text, sizeof(temp_text), "Temp: %.2f C", temp_c);
+            // Até ~10 amostras/s: detalhe só em nível debug
+            ESP_LOGD(TAG, "Temperatura: %.2f °C (%d bits, conversão em %lu ms)", temp_c, resolucao,
+                     (unsigned long)(reading.conversion_us / 1000));
+
+            DS18B20_RESOLUTION nova = ds18b20_adaptive_update(&adaptativo, temp_c, reading.timestamp_us);
+            if (nova != resolucao) {
+                resolucao = nova;
+                ds18b20_sched_set_resolution(nova);
+                ds18b20_sched_set_period(ds18b20_adaptive_period_ms(nova));
+                ESP_LOGI(TAG, "Temperatura: %.2f °C -> %d bits, uma leitura a cada %lu ms", temp_c, nova,
+                         (unsigned long)ds18b20_adaptive_period_ms(nova));
+            }
 
+            int estava = led_on;
             if (temp_c >= TEMPERATURE_THRESHOLD) {
                 led_on = 1;
                 led_intensity = 100;
                 ssr_set_duty(&ssr, led_intensity);
-                ESP_LOGW(TAG, "Temperatura alta! LED ACESO!");
+                if (!estava) {
+                    ESP_LOGW(TAG, "Temperatura alta (%.2f °C)! LED ACESO!", temp_c);
+                }
             } else {
                 led_on = 0;
                 ssr_set_duty(&ssr, 0);
-                ESP_LOGW(TAG, "Temperatura baixa! LED DESLIGADO!");
+                if (estava) {
+                    ESP_LOGW(TAG, "Temperatura baixa (%.2f °C)! LED DESLIGADO!", temp_c);
+                }
             }
         } else {
             ESP_LOGE(TAG, "Erro ao ler temperatura");
-            snprintf(temp_text, sizeof(temp_text), "Erro");
         }
 
-        ssd1306_clear_screen();  // Apaga tudo
-        ssd1306_display_text(temp_text); // Exibe o texto fixo no topo do display
-
-        vTaskDelay(pdMS_TO_TICKS(2000));  // Atualiza a cada 2 segundos
+        // Publica para o painel
+        dash_temp_c = temp_c;
+        dash_temp_ok = (err == DS18B20_OK);
+        dash_temp_seq++;
     }
 
-    ds18b20_free(&ds18b20_info);
+    ds18b20_sched_stop();
 }
 
+#if DASHBOARD_FONT_BENCHMARK_ROUNDS > 0
+// Mede o blitter de fontes em ciclos de CPU: desenha o mesmo texto em y
+// fora do alinhamento de página (o caso com deslocamento) e reporta glifos/s.
+// Só mexe na RAM; o painel apaga o framebuffer logo em seguida.
+static void font_benchmark(void) {
+    static const char text[] = "-23.45";
+    static const struct { ssd1306_font_t font; const char *name; } fonts[] = {
+        {SSD1306_FONT_8X8, "8x8"},
+        {SSD1306_FONT_5X7, "5x7"},
+        {SSD1306_FONT_DIGITS_2X, "dígitos 2x"},
+        {SSD1306_FONT_DIGITS_3X, "dígitos 3x"},
+    };
+    const uint32_t glyphs = DASHBOARD_FONT_BENCHMARK_ROUNDS * (sizeof(text) - 1);
+    const uint32_t ticks_per_us = esp_rom_get_cpu_ticks_per_us();
+
+    for (size_t f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++) {
+        ssd1306_draw_text(0, 3, text, fonts[f].font);  // Tabelas 2x/3x já prontas
+        uint32_t start = esp_cpu_get_cycle_count();
+        for (int r = 0; r < DASHBOARD_FONT_BENCHMARK_ROUNDS; r++) {
+            ssd1306_draw_text(0, 3, text, fonts[f].font);
+        }
+        uint32_t cycles = esp_cpu_get_cycle_count() - start;
+        uint64_t per_s = cycles ? (uint64_t)glyphs * ticks_per_us * 1000000ULL / cycles : 0;
+        ESP_LOGI(TAG, "Fonte %s: %lu ciclos/glifo, %llu glifos/s", fonts[f].name,
+                 (unsigned long)(cycles / glyphs), (unsigned long long)per_s);
+    }
+}
+#endif
+
+// Task do painel: único dono do framebuffer. Cada widget só redesenha a
+// própria caixa quando o valor muda, então um quadro parado não gera I2C.
+void dashboard_task(void *arg) {
+    static ssd1306_readout_t temp_readout;
+    static ssd1306_sparkline_t temp_history;
+    static ssd1306_tilt_t tilt;
+    static ssd1306_hbar_t duty_bar;
+    static ssd1306_readout_t duty_readout;
+
+#if DASHBOARD_FONT_BENCHMARK_ROUNDS > 0
+    font_benchmark();
+#endif
+    ssd1306_fb_clear();
+    ssd1306_readout_init(&temp_readout, 0, 0, 84, SSD1306_FONT_DIGITS_2X, 1, "\x7F" "C");
+    ssd1306_sparkline_init(&temp_history, 0, 18, 92, 26, 0.0f, 0.0f);
+    ssd1306_tilt_init(&tilt, 112, 16, 14, 45.0f);
+    ssd1306_draw_text(0, 50, "SSR", SSD1306_FONT_5X7);
+    ssd1306_hbar_init(&duty_bar, 20, 49, 80, 9);
+    ssd1306_readout_init(&duty_readout, 102, 50, 26, SSD1306_FONT_5X7, 0, "%");
+
+    uint32_t seen_seq = 0;
+    TickType_t last_wake = xTaskGetTickCount();
+    TickType_t last_history = 0;
+    bool history_empty = true;
+
+    while (1) {
+        uint32_t seq = dash_temp_seq;
+        if (seq != seen_seq) {
+            seen_seq = seq;
+            if (dash_temp_ok) {
+                ssd1306_readout_set(&temp_readout, dash_temp_c);
+                // A taxa de leitura varia com a resolução; o gráfico não
+                if (history_empty || xTaskGetTickCount() - last_history >= pdMS_TO_TICKS(TEMPERATURE_HISTORY_MS)) {
+                    ssd1306_sparkline_push(&temp_history, dash_temp_c);
+                    last_history = xTaskGetTickCount();
+                    history_empty = false;
+                }
+            } else {
+                ssd1306_readout_set_text(&temp_readout, "--.-");  // Só glifos da fonte de dígitos
+            }
+        }
+
+        int duty = led_on ? led_intensity : 0;
+        ssd1306_hbar_set(&duty_bar, duty);
+        ssd1306_readout_set(&duty_readout, duty);
+        ssd1306_tilt_set(&tilt, dash_roll, dash_pitch);
+
+        ssd1306_flush();
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(DASHBOARD_PERIOD_MS));
+    }
+}
 
 void app_main(void) {
+    // NVS guarda a calibração do MPU6050
+    esp_err_t nvs_err = nvs_flash_init();
+    if (nvs_err == ESP_ERR_NVS_NO_FREE_PAGES || nvs_err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        nvs_err = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(nvs_err);
+
     ssr.gpio = LED_PIN;
     ssr.mode = SSR_MODE_PWM;
     ssr.pwm_channel = LEDC_CHANNEL_0;
@@ -188,9 +617,13 @@ void app_main(void) {
     ssr.pwm_freq = 1000;
     ssr_init(&ssr);
 
+    // Display com task própria: o controle térmico nunca espera o I2C do OLED
+    ssd1306_task_start(4);
+
     button_event_queue = xQueueCreate(10, sizeof(button_event_t));
     xTaskCreate(button_task, "button_task", 4096, NULL, 10, NULL);
     xTaskCreate(temperature_task, "temperature_task", 4096, NULL, 10, NULL);
+    xTaskCreate(dashboard_task, "dashboard_task", 4096, NULL, 3, NULL);
     xTaskCreate(mpu_task, "mpu_task", 4096, NULL, 5, &mpuTaskHandle);
 
     gpio_config_t button_conf = {
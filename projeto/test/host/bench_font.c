@@ -0,0 +1,40 @@
+// ----------------------
+// Benchmark de host do blitter de fontes: glifos/s por fonte, desenhando
+// em y fora do alinhamento de página. Os números servem para comparar
+// versões na mesma máquina; o valor no alvo vem de font_benchmark() no main.
+// ----------------------
+
+#include <stdio.h>
+#include <time.h>
+#include "ssd1306_font.h"
+
+#define ROUNDS 200000
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    static const char text[] = "-23.45";
+    static const struct { ssd1306_font_t font; const char *name; } fonts[] = {
+        {SSD1306_FONT_8X8, "8x8"},
+        {SSD1306_FONT_5X7, "5x7"},
+        {SSD1306_FONT_DIGITS_2X, "dígitos 2x"},
+        {SSD1306_FONT_DIGITS_3X, "dígitos 3x"},
+    };
+    const double glyphs = (double)ROUNDS * (sizeof(text) - 1);
+
+    for (size_t f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++) {
+        ssd1306_draw_text(0, 3, text, fonts[f].font);  // Tabelas 2x/3x já prontas
+        double start = now_s();
+        for (int r = 0; r < ROUNDS; r++) {
+            ssd1306_draw_text(0, 3, text, fonts[f].font);
+        }
+        double elapsed = now_s() - start;
+        printf("bench_font %-10s %8.1f ns/glifo %12.0f glifos/s\n", fonts[f].name,
+               elapsed * 1e9 / glyphs, elapsed > 0 ? glyphs / elapsed : 0.0);
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+#ifndef I2C_BUS_FAKE_H
+#define I2C_BUS_FAKE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "i2c_bus.h"
+
+// ----------------------
+// i2c_bus falso para testes de host
+// Nada vai para um barramento: cada transação só é contada. Os pedidos
+// assíncronos terminam na hora (o callback roda dentro da chamada).
+// ----------------------
+
+typedef struct {
+    uint32_t transactions;  // Escritas e escritas+leituras (START ... STOP)
+    uint32_t probes;        // Só endereço, sem dados
+    uint32_t bytes;         // Bytes no fio, incluindo o byte de endereço
+    uint8_t last[2048];     // Dados da última escrita
+    size_t last_len;
+} i2c_bus_fake_log_t;
+
+// 🧽 Zera os contadores
+void i2c_bus_fake_reset(void);
+
+// 📊 Contadores desde o último reset
+const i2c_bus_fake_log_t *i2c_bus_fake_log(void);
+
+#endif // I2C_BUS_FAKE_H
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""Gera fixtures/mpu6050_trace.inc: amostras brutas da FIFO do MPU6050 com a
+orientação de referência de cada uma.
+
+O movimento é conhecido (rampas suaves de roll e pitch, yaw parado), então a
+referência é exata. As amostras saem como a FIFO entrega: int16, acelerômetro
+em +-4 g e giroscópio em +-250 graus/s, com bias e ruído do giroscópio, ruído
+do acelerômetro e um trecho de vibração que engana o cálculo só pelo
+acelerômetro. Seed fixa: rodar de novo gera o mesmo arquivo.
+
+    python3 gen_mpu6050_trace.py > mpu6050_trace.inc
+"""
+import math
+import random
+
+RATE_HZ = 100
+DURATION_S = 6.0
+ACCEL_LSB_PER_G = 8192.0      # MPU6050_ACCEL_FS_4G
+GYRO_LSB_PER_DPS = 131.0      # MPU6050_GYRO_FS_250DPS
+GYRO_BIAS_LSB = (52, -31, 18)
+GYRO_NOISE_LSB = 4.0
+ACCEL_NOISE_G = 0.01
+VIBRATION_G = 0.3             # Amplitude entre 4 s e 5 s
+VIBRATION_HZ = 37.0
+
+
+def ramp(t, t0, t1, a, b):
+    """Cosseno de a até b entre t0 e t1; devolve (valor, derivada)."""
+    if t <= t0:
+        return a, 0.0
+    if t >= t1:
+        return b, 0.0
+    u = (t - t0) / (t1 - t0)
+    value = a + (b - a) * 0.5 * (1.0 - math.cos(math.pi * u))
+    rate = (b - a) * 0.5 * math.pi * math.sin(math.pi * u) / (t1 - t0)
+    return value, rate
+
+
+def attitude(t):
+    """(roll, pitch, d roll, d pitch) em graus e graus/s."""
+    if t < 5.0:
+        roll, droll = ramp(t, 1.0, 2.0, 0.0, 30.0)
+        pitch, dpitch = ramp(t, 3.0, 4.0, 0.0, -20.0)
+    else:
+        roll, droll = ramp(t, 5.0, 6.0, 30.0, 0.0)
+        pitch, dpitch = ramp(t, 5.0, 6.0, -20.0, 0.0)
+    return roll, pitch, droll, dpitch
+
+
+def clamp16(x):
+    return max(-32768, min(32767, int(round(x))))
+
+
+def main():
+    rng = random.Random(1234)
+    n = int(RATE_HZ * DURATION_S)
+    print("// Gerado por gen_mpu6050_trace.py, não editar.")
+    print("// %d Hz, %d amostras: { accel XYZ, gyro XYZ, roll, pitch (centésimos de grau) }" % (RATE_HZ, n))
+    for i in range(n):
+        t = i / RATE_HZ
+        roll, pitch, droll, dpitch = attitude(t)
+        r = math.radians(roll)
+        p = math.radians(pitch)
+
+        # Gravidade no referencial do sensor (ZYX, yaw = 0)
+        g = [-math.sin(p), math.sin(r) * math.cos(p), math.cos(r) * math.cos(p)]
+        if 4.0 <= t < 5.0:
+            shake = VIBRATION_G * math.sin(2.0 * math.pi * VIBRATION_HZ * t)
+            g[0] += shake
+            g[2] += 0.5 * shake
+        accel = [clamp16((v + rng.gauss(0.0, ACCEL_NOISE_G)) * ACCEL_LSB_PER_G) for v in g]
+
+        # Taxas no corpo a partir das derivadas de Euler (yaw parado)
+        rates = [droll, dpitch * math.cos(r), -dpitch * math.sin(r)]
+        gyro = [clamp16(w * GYRO_LSB_PER_DPS + GYRO_BIAS_LSB[k] + rng.gauss(0.0, GYRO_NOISE_LSB))
+                for k, w in enumerate(rates)]
+
+        print("{{%d, %d, %d}, {%d, %d, %d}, %d, %d}," % (
+            accel[0], accel[1], accel[2], gyro[0], gyro[1], gyro[2],
+            int(round(roll * 100)), int(round(pitch * 100))))
+
+
+if __name__ == "__main__":
+    main()
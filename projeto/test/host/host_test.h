@@ -0,0 +1,29 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+// Verificações mínimas para os testes de host: cada falha é impressa e
+// contada; o executável termina com código != 0 se alguma falhou.
+
+#include <stdio.h>
+
+extern int host_test_failures;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+            host_test_failures++; \
+        } \
+    } while (0)
+
+#define CHECK_EQ(expected, actual) do { \
+        long long e_ = (long long)(expected); \
+        long long a_ = (long long)(actual); \
+        if (e_ != a_) { \
+            fprintf(stderr, "%s:%d: %s: esperado %lld, obtido %lld\n", __FILE__, __LINE__, #actual, e_, a_); \
+            host_test_failures++; \
+        } \
+    } while (0)
+
+#define HOST_TEST_DEFINE_FAILURES int host_test_failures = 0
+
+#endif // HOST_TEST_H
@@ -0,0 +1,38 @@
+#ifndef DRIVER_GPIO_H
+#define DRIVER_GPIO_H
+
+// Stub de host: tipos e constantes usados pelos componentes; a ISR
+// registrada pode ser disparada pelo teste com gpio_fake_trigger()
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef int gpio_num_t;
+typedef void (*gpio_isr_t)(void *arg);
+
+typedef enum { GPIO_MODE_INPUT, GPIO_MODE_OUTPUT } gpio_mode_t;
+typedef enum { GPIO_PULLUP_DISABLE, GPIO_PULLUP_ENABLE } gpio_pullup_t;
+typedef enum { GPIO_PULLDOWN_DISABLE, GPIO_PULLDOWN_ENABLE } gpio_pulldown_t;
+typedef enum { GPIO_INTR_DISABLE, GPIO_INTR_POSEDGE } gpio_int_type_t;
+
+typedef struct {
+    uint64_t pin_bit_mask;
+    gpio_mode_t mode;
+    gpio_pullup_t pull_up_en;
+    gpio_pulldown_t pull_down_en;
+    gpio_int_type_t intr_type;
+} gpio_config_t;
+
+#define GPIO_NUM_3  3
+#define GPIO_NUM_8  8
+#define GPIO_NUM_16 16
+
+esp_err_t gpio_config(const gpio_config_t *config);
+esp_err_t gpio_install_isr_service(int flags);
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio, gpio_isr_t isr, void *arg);
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio);
+
+// Chama a ISR registrada no pino, como faria uma borda; false se não há ISR
+int gpio_fake_trigger(gpio_num_t gpio);
+
+#endif // DRIVER_GPIO_H
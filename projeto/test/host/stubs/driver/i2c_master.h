@@ -0,0 +1,13 @@
+#ifndef DRIVER_I2C_MASTER_H
+#define DRIVER_I2C_MASTER_H
+
+// Stub de host: só os tipos que aparecem em i2c_bus.h
+
+#include "driver/gpio.h"
+
+typedef int i2c_port_t;
+
+#define I2C_NUM_0 0
+#define I2C_NUM_1 1
+
+#endif // DRIVER_I2C_MASTER_H
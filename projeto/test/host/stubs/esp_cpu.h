@@ -0,0 +1,11 @@
+#ifndef ESP_CPU_H
+#define ESP_CPU_H
+
+// Stub de host: o "contador de ciclos" conta nanossegundos do relógio
+// monotônico, então as diferenças saem em ns em vez de ciclos de CPU
+
+#include <stdint.h>
+
+uint32_t esp_cpu_get_cycle_count(void);
+
+#endif // ESP_CPU_H
@@ -0,0 +1,14 @@
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+// Stub de host: erros e avisos vão para stderr, o resto é descartado
+
+#include <stdio.h>
+#include "esp_err.h"
+
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) do { (void)(tag); } while (0)
+#define ESP_LOGD(tag, fmt, ...) do { (void)(tag); } while (0)
+
+#endif // ESP_LOG_H
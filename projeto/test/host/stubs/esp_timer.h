@@ -0,0 +1,11 @@
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+// Stub de host: relógio manual, avançado pelos testes
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
+void esp_timer_fake_advance_us(int64_t us);
+
+#endif // ESP_TIMER_H
@@ -0,0 +1,176 @@
+// Implementações de host para os stubs de ESP-IDF e FreeRTOS
+
+#include <stdlib.h>
+#include <time.h>
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
+#include "nvs.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+static int64_t s_now_us = 0;
+static int s_handle;  // Endereço não nulo para os handles
+static uint32_t s_notify_count = 0;
+static gpio_num_t s_isr_gpio = -1;
+static gpio_isr_t s_isr = NULL;
+static void *s_isr_arg = NULL;
+
+const char *esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK: return "ESP_OK";
+        case ESP_FAIL: return "ESP_FAIL";
+        case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_NVS_NOT_FOUND: return "ESP_ERR_NVS_NOT_FOUND";
+        default: return "ESP_ERR_?";
+    }
+}
+
+int64_t esp_timer_get_time(void) {
+    return s_now_us;
+}
+
+void esp_timer_fake_advance_us(int64_t us) {
+    s_now_us += us;
+}
+
+uint32_t esp_cpu_get_cycle_count(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    esp_timer_fake_advance_us((int64_t)ticks * 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return &s_handle;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    (void)task;
+    s_notify_count++;
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken) {
+    xTaskNotifyGive(task);
+    if (woken) {
+        *woken = pdTRUE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t timeout) {
+    if (s_notify_count == 0) {
+        esp_timer_fake_advance_us((int64_t)timeout * 1000);
+        return 0;
+    }
+    uint32_t count = s_notify_count;
+    s_notify_count = clear_on_exit ? 0 : count - 1;
+    return count;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                       UBaseType_t priority, TaskHandle_t *handle) {
+    (void)fn; (void)name; (void)stack; (void)arg; (void)priority; (void)handle;
+    return pdFAIL;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    (void)length; (void)item_size;
+    return &s_handle;
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item) {
+    (void)queue; (void)item;
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait) {
+    (void)queue; (void)item; (void)wait;
+    return pdFALSE;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return &s_handle;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return &s_handle;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t wait) {
+    (void)sem; (void)wait;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    (void)sem;
+    return pdTRUE;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t mode, nvs_handle_t *handle) {
+    (void)name; (void)mode;
+    *handle = 1;
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *value, size_t *length) {
+    (void)handle; (void)key; (void)value; (void)length;
+    return ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length) {
+    (void)handle; (void)key; (void)value; (void)length;
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    (void)handle;
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) {
+    (void)handle;
+}
+
+esp_err_t gpio_config(const gpio_config_t *config) {
+    (void)config;
+    return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int flags) {
+    (void)flags;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio, gpio_isr_t isr, void *arg) {
+    s_isr_gpio = gpio;
+    s_isr = isr;
+    s_isr_arg = arg;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio) {
+    if (gpio == s_isr_gpio) {
+        s_isr = NULL;
+    }
+    return ESP_OK;
+}
+
+int gpio_fake_trigger(gpio_num_t gpio) {
+    if (gpio != s_isr_gpio || s_isr == NULL) {
+        return 0;
+    }
+    s_isr(s_isr_arg);
+    return 1;
+}
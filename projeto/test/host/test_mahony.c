@@ -0,0 +1,104 @@
+// ----------------------
+// Teste de host do filtro Mahony: roda o traço de fixtures/ (amostras da
+// FIFO com a orientação de referência) pelo mesmo caminho do mpu_task
+// (calibração em repouso, bias, mpu6050_mahony_update) e compara roll/pitch.
+// ----------------------
+
+#include <math.h>
+#include "host_test.h"
+#include "mpu6050.h"
+
+HOST_TEST_DEFINE_FAILURES;
+
+#define TRACE_RATE_HZ 100
+#define TRACE_REST_SAMPLES TRACE_RATE_HZ      // 1 s parado e nivelado no início
+#define TRACE_VIBRATION_FIRST (4 * TRACE_RATE_HZ)  // 4 s a 5 s: acelerômetro sacudido
+#define TRACE_VIBRATION_LAST (5 * TRACE_RATE_HZ)
+
+// Mesmos ganhos e faixas do main
+#define MAHONY_KP 2.0f
+#define MAHONY_KI 0.01f
+
+// Erro máximo aceito contra a referência (graus)
+#define MAX_ERROR_DEG 2.0f
+
+typedef struct {
+    int16_t accel[3];
+    int16_t gyro[3];
+    int16_t roll_cdeg;   // Referência, centésimos de grau
+    int16_t pitch_cdeg;
+} trace_row_t;
+
+static const trace_row_t s_trace[] = {
+#include "fixtures/mpu6050_trace.inc"
+};
+#define TRACE_LEN (sizeof(s_trace) / sizeof(s_trace[0]))
+
+static mpu6050_sample_t to_sample(const trace_row_t *row, size_t i) {
+    mpu6050_sample_t s = {
+        .timestamp_us = (int64_t)i * 1000000 / TRACE_RATE_HZ,
+    };
+    for (int axis = 0; axis < 3; axis++) {
+        s.accel[axis] = row->accel[axis];
+        s.gyro[axis] = row->gyro[axis];
+    }
+    return s;
+}
+
+int main(void) {
+    static mpu6050_sample_t rest[TRACE_REST_SAMPLES];
+    for (size_t i = 0; i < TRACE_REST_SAMPLES; i++) {
+        rest[i] = to_sample(&s_trace[i], i);
+    }
+
+    // Calibração de partida, como no mpu_task: bias do giroscópio em repouso
+    mpu6050_calib_t calib;
+    CHECK(mpu6050_calib_compute(rest, TRACE_REST_SAMPLES, MPU6050_ACCEL_FS_4G, MPU6050_GYRO_FS_250DPS, &calib));
+
+    mpu6050_mahony_t filter;
+    mpu6050_mahony_init(&filter, TRACE_RATE_HZ, MAHONY_KP, MAHONY_KI, MPU6050_GYRO_FS_250DPS);
+    mpu6050_mahony_set_bias(&filter, calib.gyro_offset);
+
+    float max_roll_err = 0.0f, max_pitch_err = 0.0f;
+    double vib_sq_err = 0.0, vib_sq_err_accel = 0.0;
+    for (size_t i = 0; i < TRACE_LEN; i++) {
+        mpu6050_sample_t s = to_sample(&s_trace[i], i);
+        mpu6050_mahony_update(&filter, &s);
+
+        float roll, pitch;
+        mpu6050_mahony_get_euler(&filter, &roll, &pitch, NULL);
+        float ref_roll = s_trace[i].roll_cdeg * 0.01f;
+        float ref_pitch = s_trace[i].pitch_cdeg * 0.01f;
+        float roll_err = fabsf(roll - ref_roll);
+        float pitch_err = fabsf(pitch - ref_pitch);
+        if (roll_err > max_roll_err) max_roll_err = roll_err;
+        if (pitch_err > max_pitch_err) max_pitch_err = pitch_err;
+
+        if (i >= TRACE_VIBRATION_FIRST && i < TRACE_VIBRATION_LAST) {
+            // O cálculo antigo, só pelo acelerômetro, na mesma amostra
+            float ax = s.accel[0], ay = s.accel[1], az = s.accel[2];
+            float accel_roll = atan2f(ay, az) * 57.29578f;
+            float accel_pitch = atan2f(-ax, sqrtf(ay * ay + az * az)) * 57.29578f;
+            vib_sq_err += roll_err * roll_err + pitch_err * pitch_err;
+            vib_sq_err_accel += (accel_roll - ref_roll) * (accel_roll - ref_roll)
+                              + (accel_pitch - ref_pitch) * (accel_pitch - ref_pitch);
+        }
+    }
+
+    int vib_n = TRACE_VIBRATION_LAST - TRACE_VIBRATION_FIRST;
+    double vib_rms = sqrt(vib_sq_err / vib_n);
+    double vib_rms_accel = sqrt(vib_sq_err_accel / vib_n);
+    printf("test_mahony: erro máx roll %.2f, pitch %.2f graus; vibração: RMS %.2f (só acelerômetro %.2f)\n",
+           max_roll_err, max_pitch_err, vib_rms, vib_rms_accel);
+
+    CHECK(max_roll_err < MAX_ERROR_DEG);
+    CHECK(max_pitch_err < MAX_ERROR_DEG);
+    CHECK(vib_rms * 4 < vib_rms_accel);
+
+    if (host_test_failures) {
+        fprintf(stderr, "test_mahony: %d falha(s)\n", host_test_failures);
+        return 1;
+    }
+    printf("test_mahony: ok\n");
+    return 0;
+}
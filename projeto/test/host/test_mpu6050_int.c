@@ -0,0 +1,111 @@
+// ----------------------
+// Testes de host da interrupção do MPU6050: bits injetados com
+// mpu6050_int_simulate() (e bordas do GPIO falso) precisam chegar a
+// mpu6050_int_wait() uma vez só, sem acordar a task à toa.
+// ----------------------
+
+#include "host_test.h"
+#include "i2c_bus_fake.h"
+#include "esp_timer.h"
+#include "mpu6050.h"
+
+HOST_TEST_DEFINE_FAILURES;
+
+#define WAIT_TICKS pdMS_TO_TICKS(10)
+
+static void test_start(void) {
+    CHECK_EQ(ESP_OK, i2c_master_init());
+
+    const mpu6050_int_config_t config = {
+        .gpio = MPU6050_INT_GPIO,
+        .enable_mask = MPU6050_INT_MOTION | MPU6050_INT_DATA_RDY,
+        .motion_threshold = 20,
+        .motion_duration_ms = 1,
+        .notify_task = xTaskGetCurrentTaskHandle(),
+    };
+    CHECK_EQ(ESP_OK, mpu6050_int_start(&config));
+
+    // Configurar não pode deixar uma notificação pendente
+    uint8_t status = 0xFF;
+    CHECK_EQ(ESP_ERR_TIMEOUT, mpu6050_int_wait(WAIT_TICKS, &status));
+}
+
+// 🧪 DATA_READY simulado: entregue sem ler INT_STATUS no barramento
+static void test_simulated_data_ready(void) {
+    i2c_bus_fake_reset();
+    mpu6050_int_simulate(MPU6050_INT_DATA_RDY);
+    esp_timer_fake_advance_us(250);
+
+    uint8_t status = 0;
+    CHECK_EQ(ESP_OK, mpu6050_int_wait(WAIT_TICKS, &status));
+    CHECK_EQ(MPU6050_INT_DATA_RDY, status);
+    CHECK_EQ(0, i2c_bus_fake_log()->transactions);
+
+    mpu6050_int_stats_t stats;
+    mpu6050_int_get_stats(&stats);
+    CHECK_EQ(250, stats.last_latency_us);
+
+    // Já atendido: a próxima espera só acaba no timeout
+    CHECK_EQ(ESP_ERR_TIMEOUT, mpu6050_int_wait(WAIT_TICKS, &status));
+}
+
+// 🧪 Duas bordas antes da task acordar: um só wake com os bits somados e a
+// latência contada da borda mais antiga
+static void test_simulated_coalesced(void) {
+    mpu6050_int_simulate(MPU6050_INT_DATA_RDY);
+    esp_timer_fake_advance_us(100);
+    mpu6050_int_simulate(MPU6050_INT_MOTION);
+    esp_timer_fake_advance_us(100);
+
+    uint8_t status = 0;
+    CHECK_EQ(ESP_OK, mpu6050_int_wait(WAIT_TICKS, &status));
+    CHECK_EQ(MPU6050_INT_DATA_RDY | MPU6050_INT_MOTION, status);
+    CHECK_EQ(ESP_ERR_TIMEOUT, mpu6050_int_wait(WAIT_TICKS, &status));
+
+    mpu6050_int_stats_t stats;
+    mpu6050_int_get_stats(&stats);
+    CHECK_EQ(200, stats.last_latency_us);
+    CHECK_EQ(3, stats.interrupts);
+    CHECK_EQ(2, stats.data_ready_events);
+    CHECK_EQ(1, stats.motion_events);
+}
+
+// 🔔 Borda real junto com bits simulados: INT_STATUS lido uma vez
+static void test_hardware_edge(void) {
+    i2c_bus_fake_reset();
+    CHECK(gpio_fake_trigger(MPU6050_INT_GPIO));
+    mpu6050_int_simulate(MPU6050_INT_MOTION);
+
+    uint8_t status = 0;
+    CHECK_EQ(ESP_OK, mpu6050_int_wait(WAIT_TICKS, &status));
+    CHECK_EQ(MPU6050_INT_MOTION, status);  // O falso lê INT_STATUS como 0
+    const i2c_bus_fake_log_t *log = i2c_bus_fake_log();
+    CHECK_EQ(1, log->transactions);
+    CHECK_EQ(MPU6050_REG_INT_STATUS, log->last[0]);
+
+    CHECK_EQ(ESP_ERR_TIMEOUT, mpu6050_int_wait(WAIT_TICKS, &status));
+}
+
+// ⏹ Depois do stop a ISR sai do pino: nenhuma borda acorda a task
+static void test_stop(void) {
+    CHECK_EQ(ESP_OK, mpu6050_int_stop());
+    CHECK(!gpio_fake_trigger(MPU6050_INT_GPIO));
+
+    uint8_t status = 0;
+    CHECK_EQ(ESP_ERR_TIMEOUT, mpu6050_int_wait(WAIT_TICKS, &status));
+}
+
+int main(void) {
+    test_start();
+    test_simulated_data_ready();
+    test_simulated_coalesced();
+    test_hardware_edge();
+    test_stop();
+
+    if (host_test_failures) {
+        fprintf(stderr, "test_mpu6050_int: %d falha(s)\n", host_test_failures);
+        return 1;
+    }
+    printf("test_mpu6050_int: ok\n");
+    return 0;
+}
@@ -0,0 +1,160 @@
+// ----------------------
+// Testes de host do SSD1306: quantas transações e bytes I2C cada operação gera.
+// O i2c_bus é o falso de fakes/, que só conta o que seria enviado.
+// ----------------------
+
+#include <string.h>
+#include "host_test.h"
+#include "i2c_bus_fake.h"
+#include "ssd1306.h"
+#include "ssd1306_widgets.h"
+#include "ssd1306_priv.h"
+
+HOST_TEST_DEFINE_FAILURES;
+
+// Janela (0x21/0x22) = endereço + CMD_STREAM + 6 bytes de comando
+#define WINDOW_BYTES (1 + 1 + 6)
+// Dados = endereço + DATA_STREAM + colunas
+#define DATA_BYTES(cols) (1 + 1 + (cols))
+
+// 🔧 Init: a sequência inteira de configuração sai numa só transação
+static void test_init(void) {
+    i2c_bus_fake_reset();
+    CHECK_EQ(ESP_OK, ssd1306_init());
+
+    const i2c_bus_fake_log_t *log = i2c_bus_fake_log();
+    CHECK_EQ(1, log->probes);
+    CHECK_EQ(1, log->transactions);
+    CHECK_EQ(OLED_CONTROL_BYTE_CMD_STREAM, log->last[0]);
+    CHECK(log->last_len > 2);
+    CHECK_EQ(ssd1306_get_state(), SSD1306_STATE_ONLINE);
+}
+
+// 🖥 Tela inteira: uma janela + um burst com as 8 páginas
+static void test_full_flush(void) {
+    ssd1306_fb_clear();
+    i2c_bus_fake_reset();
+    CHECK_EQ(ESP_OK, ssd1306_flush());
+
+    const i2c_bus_fake_log_t *log = i2c_bus_fake_log();
+    CHECK_EQ(2, log->transactions);
+    CHECK_EQ(WINDOW_BYTES + DATA_BYTES(OLED_PAGES * OLED_WIDTH), log->bytes);
+    CHECK_EQ(OLED_CONTROL_BYTE_DATA_STREAM, log->last[0]);
+}
+
+// ✏️ Parcial: um glifo muda => janela do glifo + os 8 bytes dele
+static void test_partial_flush(void) {
+    ssd1306_draw_char(16, 3, 'A');
+    i2c_bus_fake_reset();
+    CHECK_EQ(ESP_OK, ssd1306_flush());
+
+    const i2c_bus_fake_log_t *log = i2c_bus_fake_log();
+    CHECK_EQ(2, log->transactions);
+    CHECK(log->bytes <= WINDOW_BYTES + DATA_BYTES(8));
+}
+
+// 💤 Nada mudou: nenhuma transação
+static void test_idle_flush(void) {
+    ssd1306_draw_char(16, 3, 'A');  // Página tocada com o mesmo conteúdo
+    i2c_bus_fake_reset();
+    CHECK_EQ(ESP_OK, ssd1306_flush());
+    CHECK_EQ(0, i2c_bus_fake_log()->transactions);
+}
+
+// 🔲 Cursor: a janela inteira numa transação
+static void test_set_cursor(void) {
+    i2c_bus_fake_reset();
+    ssd1306_set_cursor(0, 2);
+    CHECK_EQ(1, i2c_bus_fake_log()->transactions);
+    CHECK_EQ(WINDOW_BYTES, i2c_bus_fake_log()->bytes);
+}
+
+// 🌡 Atualização típica de temperatura: só os dígitos que mudaram vão para o
+// fio, pelo menos 10x menos bytes que redesenhar a tela inteira
+static void test_readout_bytes(void) {
+    ssd1306_readout_t temp;
+
+    // Reinit: a GDDRAM passa a ser indefinida e o próximo flush é completo
+    CHECK_EQ(ESP_OK, ssd1306_init());
+    ssd1306_fb_clear();
+    ssd1306_readout_init(&temp, 0, 0, 84, SSD1306_FONT_DIGITS_2X, 1, "\x7F" "C");
+    ssd1306_readout_set(&temp, 23.4f);
+
+    ssd1306_stats_t before;
+    ssd1306_get_stats(&before);
+    i2c_bus_fake_reset();
+    CHECK_EQ(ESP_OK, ssd1306_flush());
+    uint32_t full_bytes = i2c_bus_fake_log()->bytes;
+    CHECK_EQ(WINDOW_BYTES + DATA_BYTES(OLED_PAGES * OLED_WIDTH), full_bytes);
+
+    ssd1306_readout_set(&temp, 23.5f);
+    i2c_bus_fake_reset();
+    CHECK_EQ(ESP_OK, ssd1306_flush());
+    uint32_t update_bytes = i2c_bus_fake_log()->bytes;
+    CHECK(update_bytes > 0);
+    CHECK(update_bytes * 10 <= full_bytes);
+
+    // Os contadores do driver batem com o que o barramento viu
+    ssd1306_stats_t after;
+    ssd1306_get_stats(&after);
+    CHECK_EQ(full_bytes + update_bytes, after.bytes - before.bytes);
+
+    printf("test_ssd1306: tela inteira %u bytes, leitura atualizada %u bytes\n",
+           (unsigned)full_bytes, (unsigned)update_bytes);
+}
+
+// 📐 Widgets nas bordas: nada de divisão por zero nem coordenada negativa
+// virando uint8_t e desenhando do outro lado da tela
+static void test_widget_edges(void) {
+    ssd1306_fb_clear();
+
+    ssd1306_sparkline_t sl;
+    ssd1306_sparkline_init(&sl, 10, 10, 0, 8, 0.0f, 0.0f);
+    CHECK_EQ(1, sl.w);
+    ssd1306_sparkline_push(&sl, 1.0f);
+    ssd1306_sparkline_push(&sl, 2.0f);
+
+    ssd1306_sparkline_t zeroed = {0};
+    ssd1306_sparkline_push(&zeroed, 1.0f);  // Sem init: ignorado
+
+    // Centro no canto superior esquerdo: metade do círculo fica fora
+    ssd1306_tilt_t tilt;
+    ssd1306_tilt_init(&tilt, 2, 2, 14, 45.0f);
+    ssd1306_tilt_set(&tilt, -45.0f, -45.0f);
+
+    // Nada pode ter aparecido na metade direita nem na metade de baixo
+    uint8_t (*fb)[OLED_WIDTH] = ssd1306_fb_pages();
+    int stray = 0;
+    for (int page = 0; page < OLED_PAGES; page++) {
+        for (int col = 0; col < OLED_WIDTH; col++) {
+            if ((col >= OLED_WIDTH / 2 || page >= OLED_PAGES / 2) && fb[page][col]) {
+                stray++;
+            }
+        }
+    }
+    CHECK_EQ(0, stray);
+    CHECK(fb[0][2] != 0);  // O indicador foi desenhado
+}
+
+int main(void) {
+    // A ordem importa: o driver guarda o estado do painel entre os testes
+    test_init();
+    test_full_flush();
+    test_partial_flush();
+    test_idle_flush();
+    test_set_cursor();
+
+    ssd1306_stats_t stats;
+    ssd1306_get_stats(&stats);
+    CHECK_EQ(2, stats.flushes);
+
+    test_readout_bytes();
+    test_widget_edges();
+
+    if (host_test_failures) {
+        fprintf(stderr, "test_ssd1306: %d falha(s)\n", host_test_failures);
+        return 1;
+    }
+    printf("test_ssd1306: ok\n");
+    return 0;
+}